@@ -82,7 +82,9 @@
  * @property {String} errmsg Error string. The value will be equal to that of the built-in <tt>message</tt> property.
  * @property {integer} lowlevelErrorNo The low-level error code, if applicable.
  * @property {String} lowlevelError A human-readable version of the low-level error code.
- * @property {String} log The complete log from the internal functions.
+ * @property {String} log
+ *    The log records of the function and its probe, one per line. Only records at or above the log level are kept,
+ *    see {@link module:pc-nrfjprog-js.setLogLevel|setLogLevel}.
  *
  * @example
  * nrfprogjs.getLibraryVersion(function(err, version) {
@@ -239,9 +241,13 @@
  * @typedef SerialNumberAndDeviceInformation
  *
  * @property {integer} serialNumber
- * @property {module:pc-nrfjprog-js~DeviceInformation} deviceInfo
- * @property {module:pc-nrfjprog-js~ProbeInformation} probeInfo
- * @property {module:pc-nrfjprog-js~LibraryInformation} libraryInfo
+ * @property {module:pc-nrfjprog-js~DeviceInformation} [deviceInfo] Not set when only probe information was asked for
+ * @property {module:pc-nrfjprog-js~ProbeInformation} [probeInfo] Not set when only serial numbers were asked for
+ * @property {module:pc-nrfjprog-js~LibraryInformation} [libraryInfo] Not set when only serial numbers were asked for
+ * @property {integer} enumerationTime The time it took to read the information of this device, in microseconds
+ * @property {boolean} cached True if the information was taken from the cache, without opening the device
+ * @property {module:pc-nrfjprog-js~Error} [error] Set if the information of this device could not be read. The
+ *    information that could be read before the error is still set.
  */
 
 /**
@@ -294,6 +300,168 @@
  *    Erasing up to this address. Only relevant when using <tt>ERASE_PAGES</tt> or <tt>ERASE_PAGES_INCLUDING_UICR</tt> modes.
  */
 
+/**
+ * Selects a subset of the connected devices, and the information that is read for each of them. Devices that do not
+ * match are not opened, so the time it takes to read the devices only depends on how many match.
+ * @typedef EnumerationOptions
+ * @property {string} [serialNumberPrefix]
+ *    Only devices whose serial number starts with these decimal digits.
+ * @property {integer} [minSerialNumber=0]
+ *    Only devices with a serial number of at least this value.
+ * @property {integer} [maxSerialNumber=0xFFFFFFFF]
+ *    Only devices with a serial number of at most this value.
+ * @property {integer} [fields=nrfjprogjs.ENUMERATE_ALL_INFO]
+ *    The information to read for each device. Value must be one of:<br/>
+ *    <tt>nrfjprogjs.ENUMERATE_SERIAL_NUMBERS</tt>: Only the serial number, no device is opened.<br/>
+ *    <tt>nrfjprogjs.ENUMERATE_PROBE_INFO</tt>: Also the probe and library information. The probe is opened, but there
+ *    is no connection to its target.<br/>
+ *    <tt>nrfjprogjs.ENUMERATE_ALL_INFO</tt>: Also the device information.<br/>
+ *    The library information is the same for all devices, so it is only read once.
+ *    Ignored by {@linkcode module:pc-nrfjprog-js.getSerialNumbers|getSerialNumbers}.
+ */
+
+/**
+ * Options for watching probes being attached and detached.
+ * @typedef ProbeWatcherOptions
+ * @property {integer} pollInterval=1000
+ *    How often the connected probes are listed, in milliseconds. On Linux, the probes are instead listed as soon as a
+ *    USB device is added or removed, and only every 30 seconds otherwise.
+ * @property {integer} debounceTime=500
+ *    How long a probe has to stay attached or detached before it is reported, in milliseconds.
+ * @property {boolean} simulated=false
+ *    Take the probes from {@linkcode module:pc-nrfjprog-js.setSimulatedProbes|setSimulatedProbes} instead of the
+ *    connected probes, for testing.
+ */
+
+/**
+ * A probe that was attached or detached.
+ * @typedef ProbeEvent
+ * @property {string} type Either <tt>'attach'</tt> or <tt>'detach'</tt>
+ * @property {integer} serialNumber
+ */
+
+/**
+ * Options for monitoring the health of probes.
+ * @typedef HealthMonitorOptions
+ * @property {integer} interval=5000
+ *    How often the probes are checked, in milliseconds.
+ * @property {integer} failureThreshold=2
+ *    After how many failed checks in a row a probe is unhealthy.
+ * @property {Array} [serialNumbers]
+ *    Probes to check in addition to the probes that are open, for instance all probes of a fixture.
+ */
+
+/**
+ * Options for a log subscription.
+ * @typedef LogSubscriptionOptions
+ * @property {integer} level=nrfjprogjs.LOG_LEVEL_TRACE
+ *    The lowest level of the records to pass on. Records below the level set with
+ *    {@link module:pc-nrfjprog-js.setLogLevel|setLogLevel} are not kept in the first place.
+ * @property {integer} [serialNumber]
+ *    Only pass on the records of this probe.
+ * @property {integer} interval=100
+ *    How often new records are passed on, in milliseconds. The records found are passed on in one batch.
+ * @property {integer} maxRecordsPerSecond=1000
+ *    The records above this rate are dropped. Bursts of up to a second of records are passed on.
+ */
+
+/**
+ * The health of a probe, as seen by the health monitor.
+ * @typedef ProbeHealth
+ * @property {integer} serialNumber
+ * @property {boolean} healthy False after <tt>failureThreshold</tt> failed checks in a row
+ * @property {integer} consecutiveFailures The number of failed checks since the last successful one
+ * @property {integer} checks The number of checks
+ * @property {integer} failures The number of failed checks
+ * @property {integer} lastError The low level error of the last check, 0 if it succeeded
+ * @property {integer} lastLatency How long the last successful check took to connect to the probe, in microseconds
+ * @property {integer} averageLatency The average of all successful checks, in microseconds
+ * @property {integer} lastCheck When the probe was last checked, in milliseconds since the epoch
+ */
+
+/**
+ * Where the time of a function went, in microseconds.<br />
+ * When enabled with {@link module:pc-nrfjprog-js.setTimingEnabled|setTimingEnabled}, this object is passed to every
+ * callback as the last parameter, after the parameters listed for each function. Functions that return nothing are
+ * then passed <tt>undefined</tt> in place of their missing parameters.
+ * @typedef Timing
+ * @property {integer} queueWait Waiting for a thread of the libuv thread pool
+ * @property {integer} lockWait Waiting for other functions on the same probe to finish
+ * @property {integer} probeInit Connecting to the probe
+ * @property {integer} operation The operation itself
+ * @property {integer} cleanup Resetting the device and disconnecting from the probe
+ * @property {integer} returnConversion Converting the results into JS values
+ * @property {integer} total From the function being called until the callback is called
+ * @property {integer} executions How many times the operation ran, more than 1 if it was retried
+ */
+
+/**
+ * Timing statistics of all functions that returned since the statistics were last reset.
+ * Each phase of {@link module:pc-nrfjprog-js~Timing|Timing} is an object with the <tt>average</tt> and the
+ * <tt>max</tt> in microseconds.
+ * @typedef Stats
+ * @property {Object} methods
+ *    Statistics per function name, e.g. <tt>methods['read u32']</tt>, each with <tt>count</tt>, <tt>errors</tt>
+ *    and the phases.
+ * @property {Object} serialNumbers Statistics of the functions on each probe, keyed on serial number.
+ */
+
+/**
+ * Statistics of the calls into the nrfjprog library of one function, such as <tt>NRFJPROG_read</tt>.
+ * @typedef LibraryCallEntry
+ * @property {integer} count The number of calls
+ * @property {integer} errors The number of calls that failed
+ * @property {integer} average The average duration of the calls, in microseconds
+ * @property {integer} max The longest duration of a call, in microseconds
+ * @property {Object} errorCodes The number of failed calls per error, e.g. <tt>{ CANNOT_CONNECT: 2 }</tt>
+ * @property {Array} histogram
+ *    The number of calls per duration. Element <tt>i</tt> counts the calls that took from 2^(i-1) up to 2^i
+ *    microseconds, the last element also counts all calls that took longer.
+ */
+
+/**
+ * Statistics of all calls into the nrfjprog library since the statistics were last reset.
+ * @typedef LibraryCallStats
+ * @property {Object} functions
+ *    A {@link module:pc-nrfjprog-js~LibraryCallEntry|LibraryCallEntry} per function of the library.
+ * @property {Object} serialNumbers The same, of the calls made for each probe, keyed on serial number.
+ */
+
+/**
+ * A log record.
+ * @typedef LogRecord
+ * @property {integer} sequence Increases by one for each record, also for records that were not kept
+ * @property {integer} level
+ *    One of <tt>nrfjprogjs.LOG_LEVEL_TRACE</tt>, <tt>nrfjprogjs.LOG_LEVEL_DEBUG</tt> (the messages of the nrfjprog
+ *    library), <tt>nrfjprogjs.LOG_LEVEL_INFO</tt>, <tt>nrfjprogjs.LOG_LEVEL_WARNING</tt> or
+ *    <tt>nrfjprogjs.LOG_LEVEL_ERROR</tt>
+ * @property {number} timestamp When the record was added, in milliseconds since the epoch
+ * @property {integer} serialNumber The probe the record was added for, 0 if none
+ * @property {String} message
+ */
+
+/**
+ * The data moved in one direction between the computer and a probe.
+ * @typedef ThroughputCounter
+ * @property {integer} bytes The number of bytes moved
+ * @property {integer} transfers The number of library calls that moved data
+ * @property {integer} time How long those calls took, in microseconds
+ * @property {number} rate Bytes per second while data was moved, 0 if none was
+ */
+
+/**
+ * The data moved between the computer and a probe, each a
+ * {@link module:pc-nrfjprog-js~ThroughputCounter|ThroughputCounter}.
+ * Calls that moved nothing, such as RTT reads of an empty buffer, are not counted.
+ * @typedef Throughput
+ * @property {Object} read Memory read, also by readToFile and when searching for the RTT control block
+ * @property {Object} write Memory written
+ * @property {Object} program The data of the .hex files programmed
+ * @property {Object} verify The data of the .hex files verified
+ * @property {Object} rttUp Read from RTT up channels
+ * @property {Object} rttDown Written to RTT down channels
+ */
+
 /**
  * Alias to {@linkcode module:pc-nrfjprog-js.getLibraryVersion|getLibraryVersion}.
  * @deprecated Use {@linkcode module:pc-nrfjprog-js.getLibraryVersion|getLibraryVersion} instead.
@@ -317,6 +485,10 @@ export function getLibraryVersion(callback) {}
 /**
  * Async function to get a list of all connected devices.
  *
+ * The information of all devices is read at the same time, so this takes about as long as the slowest device. A
+ * device whose information could not be read is still in the list, with an <tt>error</tt>. There is no limit on the
+ * number of devices.
+ *
  * @example
  * nrfjprogjs.getConnectedDevices( function(err, devices) {
  *      if (err) throw err;
@@ -330,30 +502,57 @@ export function getLibraryVersion(callback) {}
  *      }
  * });
  *
+ * @param {module:pc-nrfjprog-js~EnumerationOptions} [options] The devices and information to read
  * @param {Function} callback A callback function to handle the async response.
  *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Array of {@link module:pc-nrfjprog-js~SerialNumberAndDeviceInformation|SerialNumberAndDeviceInformation}).
  */
-export function getConnectedDevices(callback) {}
+export function getConnectedDevices(options, callback) {}
+
+/**
+ * Async function to discover all connected devices, passing each device on as soon as its information is read.
+ * The devices are read at the same time, and passed on in the order they are done, so work on the first devices can
+ * start while slower devices are still being read. The callback is called when all devices are passed on.
+ *
+ * @example
+ * nrfjprogjs.discoverDevices(function(err, device) {
+ *      if (device.error) return;
+ *      startJob(device.serialNumber);
+ * }, function(err, deviceCount) {
+ *      if (err) throw err;
+ *      console.log('Discovered ' + deviceCount + ' devices');
+ * });
+ *
+ * @param {module:pc-nrfjprog-js~EnumerationOptions} [options] The devices and information to read
+ * @param {Function} deviceCallback A callback function that is called for each device.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, {@link module:pc-nrfjprog-js~SerialNumberAndDeviceInformation|SerialNumberAndDeviceInformation}).
+ *   The error is always undefined, an error while reading the device is in the <tt>error</tt> of the device.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, the number of devices).
+ */
+export function discoverDevices(options, deviceCallback, callback) {}
 
 /**
  * Async function to get the serial numbers of all connected devices.
  *
  * @example
- * nrfjprogjs.getSerialNumbers(function(err, serialNumbers) {
+ * nrfjprogjs.getSerialNumbers({ serialNumberPrefix: '683' }, function(err, serialNumbers) {
  *      if (err) throw err;
  *      for (let i = 0; i < serialNumbers.length; i++) {
  *          console.log(serialNumbers[i]);
  *      }
  * });
  *
+ * @param {module:pc-nrfjprog-js~EnumerationOptions} [options] Only return the serial numbers that match
  * @param {Function} callback A callback function to handle the async response.
  *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Array of {integer}.
  */
-export function getSerialNumbers(callback) {}
+export function getSerialNumbers(options, callback) {}
 
 /**
  * Async function to get information of a single device, given its serial number.
  *
+ * The information is cached per device and coprocessor, see {@linkcode module:pc-nrfjprog-js.invalidateDeviceInfo|invalidateDeviceInfo}.
+ *
  * @example
  * nrfjprogjs.getDeviceInfo(123456789, function(err, info) {
  *      if (err) throw err;
@@ -371,6 +570,8 @@ export function getDeviceInfo(serialNumber, callback) {}
 /**
  * Async function to get information of a single device, given its serial number.
  *
+ * The information is cached per device, see {@linkcode module:pc-nrfjprog-js.invalidateDeviceInfo|invalidateDeviceInfo}.
+ *
  * @example
  * nrfjprogjs.getProbeInfo(123456789, function(err, info) {
  *      if (err) throw err;
@@ -388,6 +589,8 @@ export function getProbeInfo(serialNumber, callback) {}
 /**
  * Async function to get information about the low level library used by the device, given its serial number.
  *
+ * The information is cached per device, see {@linkcode module:pc-nrfjprog-js.invalidateDeviceInfo|invalidateDeviceInfo}.
+ *
  * @example
  * nrfjprogjs.getLibraryInfo(123456789, function(err, info) {
  *      if (err) throw err;
@@ -400,6 +603,327 @@ export function getProbeInfo(serialNumber, callback) {}
  */
 export function getLibraryInfo(serialNumber, callback) {}
 
+/**
+ * Async function to invalidate the cached information of a device, or of all devices.
+ *
+ * The device, probe and library information returned by {@linkcode module:pc-nrfjprog-js.getDeviceInfo|getDeviceInfo},
+ * {@linkcode module:pc-nrfjprog-js.getProbeInfo|getProbeInfo}, {@linkcode module:pc-nrfjprog-js.getLibraryInfo|getLibraryInfo},
+ * {@linkcode module:pc-nrfjprog-js.getConnectedDevices|getConnectedDevices} and
+ * {@linkcode module:pc-nrfjprog-js.discoverDevices|discoverDevices} is cached per serial number. The cache of a device is
+ * invalidated when it is programmed or recovered, when it can not be opened, and when it is not found by an enumeration.
+ * Use this function when the information may have changed in another way, for instance when the target connected to
+ * a probe was replaced.
+ *
+ * @example
+ * nrfjprogjs.invalidateDeviceInfo(123456789, function(err) {
+ *      if (err) throw err;
+ * });
+ *
+ * @param {integer} [serialNumber] The serial number of the device to invalidate. Without it, all devices are invalidated.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function invalidateDeviceInfo(serialNumber, callback) {}
+
+/**
+ * Async function to start watching probes being attached and detached, instead of polling
+ * {@linkcode module:pc-nrfjprog-js.getSerialNumbers|getSerialNumbers}. The probes that are connected when the watcher
+ * starts are reported as attached right away.
+ *
+ * When a probe is detached, its cached information is invalidated, and if it was opened or RTT was started on it, it is
+ * closed.
+ *
+ * @example
+ * nrfjprogjs.startProbeWatcher({ debounceTime: 1000 }, function(err, event) {
+ *      if (event.type === 'attach') {
+ *          startJob(event.serialNumber);
+ *      }
+ * }, function(err) {
+ *      if (err) throw err;
+ * });
+ *
+ * @param {module:pc-nrfjprog-js~ProbeWatcherOptions} options
+ * @param {Function} eventCallback A callback function that is called for each probe that is attached or detached.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, {@link module:pc-nrfjprog-js~ProbeEvent|ProbeEvent}).
+ *   The error is always undefined.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}). Fails if the watcher is already started.
+ */
+export function startProbeWatcher(options, eventCallback, callback) {}
+
+/**
+ * Async function to stop watching probes. Pending events are passed on before the callback is called.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function stopProbeWatcher(callback) {}
+
+/**
+ * Async function to set the probes that a simulated probe watcher sees as connected.
+ *
+ * @example
+ * nrfjprogjs.setSimulatedProbes([123456789, 987654321], function(err) {
+ *      if (err) throw err;
+ * });
+ *
+ * @param {Array} serialNumbers The serial numbers of the simulated probes
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}). Fails if no simulated watcher is started.
+ */
+export function setSimulatedProbes(serialNumbers, callback) {}
+
+/**
+ * Async function to start checking the health of probes in the background, so jobs can skip unhealthy probes instead
+ * of waiting for them to time out. Every interval, each open probe and each probe in the options is connected to and
+ * its probe information is read. All probes are checked at the same time, while other functions wait. A probe with
+ * RTT started is checked between RTT reads and writes.
+ *
+ * @example
+ * nrfjprogjs.startHealthMonitor({ interval: 10000 }, function(err, health) {
+ *      if (!health.healthy) {
+ *          console.log(health.serialNumber + ' stopped responding');
+ *      }
+ * }, function(err) {
+ *      if (err) throw err;
+ * });
+ *
+ * @param {module:pc-nrfjprog-js~HealthMonitorOptions} options
+ * @param {Function} eventCallback A callback function that is called each time a probe becomes unhealthy, or healthy
+ *   again. It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, {@link module:pc-nrfjprog-js~ProbeHealth|ProbeHealth}).
+ *   The error is always undefined.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}). Fails if the monitor is already started.
+ */
+export function startHealthMonitor(options, eventCallback, callback) {}
+
+/**
+ * Async function to stop checking the health of probes. Pending events are passed on before the callback is called.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function stopHealthMonitor(callback) {}
+
+/**
+ * Async function to get the health of all monitored probes. This does not wait for other functions.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Array of {@link module:pc-nrfjprog-js~ProbeHealth|ProbeHealth}).
+ *   Fails if the monitor is not started.
+ */
+export function getProbeHealth(callback) {}
+
+/**
+ * Async function to get the timing statistics of all functions. This does not wait for other functions.
+ *
+ * @example
+ * nrfjprogjs.getStats( function(err, stats) {
+ *      if (err) throw err;
+ *      console.log( 'Average wait for the probe: ' + stats.methods['read'].lockWait.average + 'us' );
+ * });
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, {@link module:pc-nrfjprog-js~Stats|Stats}).
+ */
+export function getStats(callback) {}
+
+/**
+ * Async function to reset the timing statistics of all functions.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function resetStats(callback) {}
+
+/**
+ * Async function to pass the {@link module:pc-nrfjprog-js~Timing|Timing} of each function to its callback, as an
+ * extra parameter after the parameters listed for the function. It is off by default, so callbacks get only the
+ * listed parameters. The statistics of {@link module:pc-nrfjprog-js.getStats|getStats} are kept either way.
+ *
+ * @example
+ * nrfjprogjs.setTimingEnabled(true, function(err) {
+ *      nrfjprogjs.read(12345678, 0, 16, function(err, data, timing) {
+ *          console.log('Waited ' + timing.lockWait + 'us for the probe');
+ *      });
+ * });
+ *
+ * @param {boolean} enabled Whether to pass the timing.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function setTimingEnabled(enabled, callback) {}
+
+/**
+ * Async function to get how often each function of the nrfjprog library was called, how long the calls took and
+ * how they failed. This does not wait for other functions.
+ *
+ * @example
+ * nrfjprogjs.getLibraryCallStats( function(err, stats) {
+ *      if (err) throw err;
+ *      const read = stats.functions['NRFJPROG_read'];
+ *      console.log( read.count + ' reads, ' + read.errors + ' failed, ' + read.average + 'us on average' );
+ * });
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, {@link module:pc-nrfjprog-js~LibraryCallStats|LibraryCallStats}).
+ */
+export function getLibraryCallStats(callback) {}
+
+/**
+ * Async function to reset the statistics of the calls into the nrfjprog library.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function resetLibraryCallStats(callback) {}
+
+/**
+ * Async function to get how much data was moved between the computer and each probe, and how fast.
+ * Comparing the rates of probes helps to find bad cables, hubs or clock speed settings.
+ * This does not wait for other functions.
+ *
+ * @example
+ * nrfjprogjs.getThroughputStats( function(err, stats) {
+ *      if (err) throw err;
+ *      Object.keys(stats).forEach(serialNumber => {
+ *          console.log( serialNumber + ' programs at ' + stats[serialNumber].program.rate + ' bytes/s' );
+ *      });
+ * });
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Object). The object has a
+ *   {@link module:pc-nrfjprog-js~Throughput|Throughput} for each probe, keyed on serial number.
+ */
+export function getThroughputStats(callback) {}
+
+/**
+ * Async function to reset the throughput counters of all probes.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function resetThroughputStats(callback) {}
+
+/**
+ * Async function to start recording a trace of what the functions do, in the Chrome trace event format.
+ * A trace can be loaded in <tt>chrome://tracing</tt> or {@link https://ui.perfetto.dev|Perfetto}.
+ *
+ * Each probe has a track with the functions run on it and the library calls they make, functions without a
+ * probe share one track, and the JS thread has a track with the parsing of parameters, the progress callbacks and
+ * the callbacks. Time spent waiting for a thread and for other functions on the same probe is shown as async spans.
+ *
+ * The events are kept in memory until {@link module:pc-nrfjprog-js.flushTrace|flushTrace} is called. When there
+ * are more than <tt>capacity</tt> events, the oldest are dropped. Starting the trace again drops all events.
+ *
+ * @example
+ * nrfjprogjs.startTrace({ capacity: 100000 }, function(err) {
+ *      if (err) throw err;
+ *      // ...
+ *      nrfjprogjs.flushTrace('/tmp/nrfjprog-trace.json', function(err, eventCount) {
+ *          if (err) throw err;
+ *          console.log( 'Wrote ' + eventCount + ' events' );
+ *      });
+ * });
+ *
+ * @param {Object} [options] Optional parameters.
+ * @param {integer} [options.capacity=65536] How many events are kept in memory.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function startTrace(options, callback) {}
+
+/**
+ * Async function to set the lowest level of the log records that are kept. The default is
+ * <tt>nrfjprogjs.LOG_LEVEL_DEBUG</tt>, which keeps the messages of the nrfjprog library.
+ * <tt>nrfjprogjs.LOG_LEVEL_NONE</tt> keeps no records at all.
+ *
+ * The last 1024 records are kept in memory, messages longer than 240 characters are truncated.
+ *
+ * @param {integer} level The lowest level to keep.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function setLogLevel(level, callback) {}
+
+/**
+ * Async function to get the log records that are still in memory. This does not wait for other functions.
+ *
+ * @example
+ * let since = 0;
+ * nrfjprogjs.getLog({ since, level: nrfjprogjs.LOG_LEVEL_WARNING }, function(err, records) {
+ *      if (err) throw err;
+ *      records.forEach(record => console.log(record.serialNumber + ': ' + record.message));
+ *      if (records.length > 0) since = records[records.length - 1].sequence + 1;
+ * });
+ *
+ * @param {Object} [options] Optional parameters.
+ * @param {integer} [options.since=0] The sequence number of the first record to get.
+ * @param {integer} [options.level=nrfjprogjs.LOG_LEVEL_TRACE] The lowest level of the records to get.
+ * @param {integer} [options.serialNumber] Only get the records of this probe.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Array of
+ *   {@link module:pc-nrfjprog-js~LogRecord|LogRecord}), oldest first.
+ */
+export function getLog(options, callback) {}
+
+/**
+ * Async function to have the log records passed on while they are added, for instance to ship them to a log
+ * collector. A background thread picks up the new records every interval, so the functions that add them are not
+ * slowed down. This does not wait for other functions.
+ *
+ * Records are dropped when they are overwritten before they are picked up, when they exceed
+ * <tt>maxRecordsPerSecond</tt>, or when more than 1024 records are waiting for JS. The number of records dropped
+ * since the last batch is passed along with each batch.
+ *
+ * @example
+ * nrfjprogjs.subscribeLog({ level: nrfjprogjs.LOG_LEVEL_DEBUG }, function(err, records, dropped) {
+ *      records.forEach(record => collector.send(record));
+ *      if (dropped > 0) {
+ *          console.log(dropped + ' log records were dropped');
+ *      }
+ * }, function(err) {
+ *      if (err) throw err;
+ * });
+ *
+ * @param {module:pc-nrfjprog-js~LogSubscriptionOptions} options
+ * @param {Function} recordsCallback A callback function that is called with each batch of records. It shall expect
+ *   three parameters: ({@link module:pc-nrfjprog-js~Error|Error}, Array of
+ *   {@link module:pc-nrfjprog-js~LogRecord|LogRecord}, integer), the records oldest first and the number of records
+ *   that were dropped. The error is always undefined.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}). Fails if there already is a
+ *   subscription.
+ */
+export function subscribeLog(options, recordsCallback, callback) {}
+
+/**
+ * Async function to stop passing on log records. The records added until then are passed on before the callback is
+ * called.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function unsubscribeLog(callback) {}
+
+/**
+ * Async function to stop recording the trace. The events that were recorded are kept until they are flushed.
+ *
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link module:pc-nrfjprog-js~Error|Error}).
+ */
+export function stopTrace(callback) {}
+
+/**
+ * Async function to write the recorded events to a JSON file, and drop them from memory. The trace is not stopped.
+ *
+ * @param {string} filename The file to write, it is overwritten if it exists.
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link module:pc-nrfjprog-js~Error|Error}, integer). The integer is the number
+ *   of events written.
+ */
+export function flushTrace(filename, callback) {}
+
 /**
  * Async function to read a chunk of memory. The data received by the callback
  * is an array of integers, each of them representing a single byte (with values
@@ -143,8 +143,39 @@
  * Option flags to be used when starting RTT. This may speed up the process of locating the control block, and the RTT Start. If <tt>controlBlockLocation</tt>
  * specified, only that location will be searched for the RTT control block, and an error will be returned if no control block where found. If no value
  * is specified for <tt>controlBlockLocation</tt>, the RAM will be searched for the location of the RTT control block.
+ *
+ * While the control block is searched for, the device is polled with an interval that starts at <tt>searchInitialInterval</tt>
+ * and doubles after every poll up to <tt>searchMaxInterval</tt>. Other functions may run on other devices between the polls.
+ *
+ * By default the device is reset before RTT is started. With <tt>reset</tt> set to <tt>false</tt>, RTT attaches to the running
+ * firmware instead and its state is kept. The control block is then usually found in the first poll. If the location of the
+ * control block is not known, <tt>searchRangeStart</tt> and <tt>searchRangeLength</tt> limit the search to a part of the RAM,
+ * which is much faster than searching all of it. If it is not found in the range, all of the RAM is searched.
+ *
+ * With <tt>elfPath</tt>, the location is taken from the <tt>_SEGGER_RTT</tt> symbol in the ELF file of the firmware, so
+ * the control block is read directly instead of searched for. The symbol table is only parsed once per image. If the
+ * symbol is not in the file, the control block is searched for as above.
+ *
+ * If <tt>bufferSize</tt> is set, all up channels are read continuously into a host side buffer of that size per channel,
+ * and <tt>rttRead</tt> and <tt>rttReadMany</tt> return data from that buffer. Data that does not fit is dropped and
+ * counted, see <tt>rttGetBufferStatistics</tt>. A device with buffered channels can not be subscribed to.
+ *
+ * With <tt>autoRecover</tt> set, RTT survives resets of the target, for instance by a watchdog. When a read or write fails,
+ * RTT is started again at the cached location of the control block, polling with the search intervals and timeout above,
+ * and the channel information is read again. If <tt>controlBlockLocation</tt> is not given, the location is looked up in
+ * the data RAM of the device once the control block is found. Subscriptions, captures and write queues keep running.
+ * A read or write that needed the recovery returns no data. See <tt>rttGetSessionStatistics</tt> for the reconnects.
  * @typedef StartOptions
  * @property {integer} [controlBlockLocation] The location of the control block. If this location is not the start of the RTT control block, start will fail.
+ * @property {integer} [searchInitialInterval=10] The time before the second poll for the control block, in milliseconds
+ * @property {integer} [searchMaxInterval=200] The longest time between two polls for the control block, in milliseconds
+ * @property {integer} [searchTimeout=5000] The time to search for the control block before giving up, in milliseconds
+ * @property {integer} [bufferSize=0] The size of the host side buffer for each up channel, in bytes. 0 disables buffering.
+ * @property {boolean} [reset=true] Reset the device before starting RTT
+ * @property {integer} [searchRangeStart] The start address of the RAM range to search for the control block
+ * @property {integer} [searchRangeLength] The length of the RAM range to search for the control block, in bytes
+ * @property {string} [elfPath] The path to the ELF file of the firmware, to look up the location of the control block in
+ * @property {boolean} [autoRecover=false] Start RTT again after read and write errors instead of stopping it
  */
 
 /**
@@ -156,7 +187,8 @@
  *
  * <p>The RTT protocol uses down channels to write to the device and up channels to read from the device.</p>
  *
- * <p>You can only open RTT on one device at any given time.</p>
+ * <p>RTT can be open on several devices at the same time. Every device has its own RTT session
+ * with its own time base, and RTT functions on one device do not wait for functions on other devices.</p>
  *
  * <p>When you have an open RTT session, you should not call any functions in <tt>pc-nrfjprog-js</tt>,
  * as these will reset the device.<p>
@@ -187,8 +219,9 @@
  * @param {integer} serialNumber The serial number of the device to start RTT on
  * @param {StartOptions} startOptions A plain object containing options about how to start RTT
  * @param {Function} callback A callback function to handle the async response.
- *   It shall expect three parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, Array of {@link pc-nrfjprog-js.module:RTT~ChannelInfo|ChannelInfo},
- *   Array of {@link pc-nrfjprog-js.module:RTT~ChannelInfo|ChannelInfo})
+ *   It shall expect four parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, Array of {@link pc-nrfjprog-js.module:RTT~ChannelInfo|ChannelInfo},
+ *   Array of {@link pc-nrfjprog-js.module:RTT~ChannelInfo|ChannelInfo}, integer). The last parameter is the time it took
+ *   to find the control block, in microseconds.
  */
 export function rttStart(serialnumber, startoptions, callback) {}
 
@@ -234,6 +267,35 @@ export function rttStop(serialnumber, callback) {}
  */
 export function rttRead(serialnumber, channelIndex, length, callback) {}
 
+/**
+ * A request to read from one up channel with <tt>rttReadMany</tt>.
+ * @typedef ChannelRead
+ * @property {integer} channel The RTT up channel index to read from
+ * @property {integer} maxLength The max amount of bytes to read from the channel
+ */
+
+/**
+ * <p>Async function to read from several RTT up channels in one call. All channels are read in
+ * one pass on the device, so this is much cheaper than calling <tt>rttRead</tt> once per channel.</p>
+ *
+ * <p>The callback gets one <tt>Buffer</tt> per requested channel, in the same order as the requests.
+ * The buffer is empty if the channel had no data. All channels share one timestamp, the time
+ * elapsed since RTT was started when the pass began, in microseconds.</p>
+ *
+ * @example
+ * nrfjprogjs.rttReadMany(12345678, [{ channel: 0, maxLength: 1024 }, { channel: 1, maxLength: 4096 }], function(err, buffers, timeSinceRTTStartInUs) {
+ *      if (err) throw err;
+ *      console.log('Log:', buffers[0].toString());
+ *      console.log('Trace bytes:', buffers[1].length);
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to read RTT on
+ * @param {ChannelRead[]} channels The RTT up channels to read from
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect three parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, Array of Buffer, integer)
+ */
+export function rttReadMany(serialnumber, channels, callback) {}
+
 /**
  * Async function to write data to a down channel on the device. You write on the down channel specified by
  * the <tt>channelIndex</tt>. The <tt>data</tt> written may either be a string or an array of integers. String
@@ -261,3 +323,351 @@ export function rttRead(serialnumber, channelIndex, length, callback) {}
  */
 export function rttWrite(serialnumber, channelIndex, data, callback) {}
 
+
+/**
+ * Options for an RTT subscription. The reader polls the subscribed up channels every
+ * <tt>minPollInterval</tt> milliseconds while data is flowing, and doubles the interval
+ * for every idle poll up to <tt>maxPollInterval</tt>.
+ *
+ * With <tt>framing</tt> the data is split into records natively, and every
+ * {@link pc-nrfjprog-js.module:RTT~Chunk|Chunk} holds one complete record. Possible values are:<br/>
+ *    <tt>nrfjprogjs.RTT_FRAMING_NONE</tt>: Chunks hold the data as it was read (default)<br/>
+ *    <tt>nrfjprogjs.RTT_FRAMING_LINE</tt>: Every record is a line. The newline, and a carriage return before it, is removed.
+ *    Lines longer than <tt>maxLineLength</tt> are split.<br/>
+ *    <tt>nrfjprogjs.RTT_FRAMING_LENGTH_PREFIX</tt>: Every record starts with its length as a little endian integer of
+ *    <tt>lengthPrefixSize</tt> bytes. The prefix is removed. A length above <tt>maxRecordLength</tt> means the data is
+ *    corrupt or out of sync. Bytes are then dropped, one at a time, until a valid length is found, and a warning with
+ *    the number of dropped bytes is added to the log.<br/>
+ * @typedef SubscribeOptions
+ * @property {integer} [minPollInterval=1] The shortest time between two polls, in milliseconds
+ * @property {integer} [maxPollInterval=50] The longest time between two polls, in milliseconds
+ * @property {integer} [readLength=1024] The max amount of bytes to read from a channel in one read
+ * @property {integer} [framing=nrfjprogjs.RTT_FRAMING_NONE] How to split the data into records
+ * @property {integer} [lengthPrefixSize=2] The size of the length prefix of a record, in bytes
+ * @property {integer} [maxLineLength=4096] The max length of a line, in bytes
+ * @property {integer} [maxRecordLength=65536] The max length of a length prefixed record, in bytes
+ */
+
+/**
+ * A chunk of data received on an up channel.
+ * @typedef Chunk
+ * @property {integer} channelIndex The up channel the data was read from
+ * @property {Buffer} data The data that was read
+ * @property {integer} time The time elapsed since RTT was started when the data was received, in microseconds.
+ *   The time is taken from a monotonic clock.
+ */
+
+/**
+ * <p>Async function to subscribe to data on one or more RTT up channels.</p>
+ *
+ * <p>A native reader polls the channels in the background and calls <tt>dataCallback</tt>
+ * with all the data read since the previous call, so there is no need to call
+ * <tt>rttRead</tt> in a loop. RTT must be started with <tt>rttStart</tt> first. There may be
+ * one subscription per device, and it ends when <tt>rttUnsubscribe</tt> or <tt>rttStop</tt>
+ * is called.</p>
+ *
+ * <p>If reading fails, <tt>dataCallback</tt> is called with an
+ * {@link pc-nrfjprog-js.module:RTT~Error|Error} and the subscription ends.</p>
+ *
+ * @example
+ * nrfjprogjs.rttSubscribe(12345678, [0, 1], {}, function(err, chunks) {
+ *      if (err) throw err;
+ *      chunks.forEach(function(chunk) {
+ *          console.log(chunk.channelIndex, chunk.time, chunk.data.toString());
+ *      });
+ * }, function(err) {
+ *      if (err) console.error('Could not subscribe');
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to read RTT on
+ * @param {integer[]} channels The RTT up channel indexes to read from
+ * @param {SubscribeOptions} subscribeOptions A plain object containing options about how to poll the channels
+ * @param {Function} dataCallback A callback function called with the received data.
+ *   It shall expect two parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, Array of {@link pc-nrfjprog-js.module:RTT~Chunk|Chunk})
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ */
+export function rttSubscribe(serialnumber, channels, subscribeOptions, dataCallback, callback) {}
+
+/**
+ * Async function to end an RTT subscription. Data read before the call is still delivered.
+ *
+ * @example
+ * nrfjprogjs.rttUnsubscribe(12345678, function(err) {
+ *     if (err) console.error('Unsubscribing failed');
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to end the subscription on
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error}). Fails, without ending
+ *   anything, if the device has a capture, a shared ring or host buffering instead of a subscription.
+ */
+export function rttUnsubscribe(serialnumber, callback) {}
+
+/**
+ * Options for an RTT capture. The options of {@link pc-nrfjprog-js.module:RTT~SubscribeOptions|SubscribeOptions}
+ * can also be used, to set how the channel is polled and how the data is split into records. Lines are written
+ * with a newline after them, length prefixed records with their length prefix in front, and data without framing as
+ * it was read.
+ *
+ * When the file would grow beyond <tt>maxFileSize</tt>, it is renamed to <tt>path.1</tt>, an existing <tt>path.1</tt>
+ * is renamed to <tt>path.2</tt> and so on, and a new file is started. Only <tt>maxFiles</tt> old files are kept.
+ * @typedef CaptureOptions
+ * @property {integer} [maxFileSize=0] The max size of the file in bytes before it is rotated. 0 disables rotation.
+ * @property {integer} [maxFiles=10] The max amount of rotated files to keep
+ * @property {boolean} [timestamps=false] Record the time each record was received since RTT was started, as
+ *   <tt>seconds.microseconds</tt>. With line framing each line is prefixed with <tt>[seconds.microseconds]</tt>.
+ *   Binary data is written unchanged, and the times go to a side index file, the capture path with
+ *   <tt>.index</tt> appended, which has one line per record: its offset in the capture file and the time.
+ * @property {integer} [statisticsInterval=1000] The time between two statistics reports, in milliseconds
+ */
+
+/**
+ * Statistics for an RTT capture.
+ * @typedef CaptureStatistics
+ * @property {String} path The path of the file
+ * @property {integer} bytesReceived The amount of bytes received from the device
+ * @property {integer} bytesWritten The amount of bytes written to the capture files, including line timestamps,
+ *   newlines and length prefixes, but not the index
+ * @property {integer} records The amount of records written
+ * @property {integer} rotations The amount of times the file has been rotated
+ */
+
+/**
+ * <p>Async function to capture the data of an RTT up channel to a file.</p>
+ *
+ * <p>The data is written to the file natively in the background, and <tt>statisticsCallback</tt> is called
+ * every <tt>statisticsInterval</tt> milliseconds. RTT must be started with <tt>rttStart</tt> first. A capture
+ * takes the place of a subscription, so a device can not be captured and subscribed to at the same time.
+ * The capture ends when <tt>rttStopCapture</tt> or <tt>rttStop</tt> is called, and the last statistics
+ * are reported after that.</p>
+ *
+ * <p>If reading or writing fails, <tt>statisticsCallback</tt> is called with an
+ * {@link pc-nrfjprog-js.module:RTT~Error|Error} and the capture ends.</p>
+ *
+ * @example
+ * nrfjprogjs.rttCapture(12345678, 0, '/tmp/device.log', { framing: nrfjprogjs.RTT_FRAMING_LINE, timestamps: true, maxFileSize: 10000000 },
+ *      function(err, statistics) {
+ *          if (err) throw err;
+ *          console.log(statistics.bytesWritten, statistics.rotations);
+ *      }, function(err) {
+ *          if (err) console.error('Could not start the capture');
+ *      });
+ *
+ * @param {integer} serialNumber The serial number of the device to capture RTT on
+ * @param {integer} channelIndex The RTT up channel index to capture
+ * @param {String} path The file to write to. An existing file is overwritten.
+ * @param {CaptureOptions} captureOptions A plain object containing options about how to capture the channel
+ * @param {Function} statisticsCallback A callback function called with the statistics of the capture.
+ *   It shall expect two parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, {@link pc-nrfjprog-js.module:RTT~CaptureStatistics|CaptureStatistics})
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ */
+export function rttCapture(serialnumber, channelIndex, path, captureOptions, statisticsCallback, callback) {}
+
+/**
+ * Async function to end an RTT capture.
+ *
+ * @example
+ * nrfjprogjs.rttStopCapture(12345678, function(err) {
+ *     if (err) console.error('Stopping the capture failed');
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to end the capture on
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error}). Fails, without ending
+ *   anything, if the device has a subscription, a shared ring or host buffering instead of a capture.
+ */
+export function rttStopCapture(serialnumber, callback) {}
+
+/**
+ * Async function to write the data of an up channel directly into a <tt>SharedArrayBuffer</tt>, without a callback
+ * or an allocation per chunk. This is meant for high rate binary channels, read by a worker with <tt>Atomics</tt>.
+ *
+ * The buffer starts with <tt>RTT_SHARED_RING_HEADER_WORDS</tt> 32 bit words, the rest of it is the ring:
+ * <ul>
+ * <li><tt>RTT_SHARED_RING_WRITE_INDEX</tt>: The number of bytes written, published after the data is in the ring</li>
+ * <li><tt>RTT_SHARED_RING_READ_INDEX</tt>: The number of bytes read, to be updated by JS after reading</li>
+ * <li><tt>RTT_SHARED_RING_DROPPED</tt>: The number of bytes dropped because the ring was full</li>
+ * <li><tt>RTT_SHARED_RING_STATE</tt>: <tt>RTT_SHARED_RING_RUNNING</tt>, <tt>RTT_SHARED_RING_STOPPED</tt> or
+ * <tt>RTT_SHARED_RING_FAILED</tt></li>
+ * </ul>
+ * Both indexes wrap at 2<sup>32</sup>, the unread data starts at <tt>readIndex</tt> modulo the ring length. The header is
+ * reset when the ring is opened. Data is written as it is received, the framing options are not used.
+ *
+ * Subscriptions, captures, host side buffering and shared rings of a device can not be used at the same time.
+ *
+ * @example
+ * const shared = new SharedArrayBuffer(4 * nrfjprogjs.RTT_SHARED_RING_HEADER_WORDS + 65536);
+ * const header = new Uint32Array(shared, 0, nrfjprogjs.RTT_SHARED_RING_HEADER_WORDS);
+ * const ring = new Uint8Array(shared, 4 * nrfjprogjs.RTT_SHARED_RING_HEADER_WORDS);
+ *
+ * nrfjprogjs.rttOpenSharedRing(12345678, 1, shared, {}, function(err) {
+ *      console.log('The ring stopped', err);
+ * }, function(err) {
+ *      if (err) throw err;
+ *      setInterval(function() {
+ *          let readIndex = header[nrfjprogjs.RTT_SHARED_RING_READ_INDEX];
+ *          const writeIndex = Atomics.load(header, nrfjprogjs.RTT_SHARED_RING_WRITE_INDEX);
+ *          for (; readIndex !== writeIndex; readIndex = (readIndex + 1) >>> 0) {
+ *              handleByte(ring[readIndex % ring.length]);
+ *          }
+ *          Atomics.store(header, nrfjprogjs.RTT_SHARED_RING_READ_INDEX, readIndex);
+ *      }, 10);
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to read from
+ * @param {integer} channelIndex The up channel to read
+ * @param {SharedArrayBuffer} sharedArrayBuffer The buffer to write into, at most 2 GB plus the header
+ * @param {pc-nrfjprog-js.module:RTT~SubscribeOptions} subscribeOptions The poll intervals and read length
+ * @param {Function} errorCallback A callback function that is called if reading from the device fails.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ */
+export function rttOpenSharedRing(serialnumber, channelIndex, sharedArrayBuffer, subscribeOptions, errorCallback, callback) {}
+
+/**
+ * Async function to stop writing into a shared ring. The state in the header is then <tt>RTT_SHARED_RING_STOPPED</tt>.
+ *
+ * @param {integer} serialNumber The serial number of the device to stop writing the ring for
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error}). Fails, without ending
+ *   anything, if the device has a subscription, a capture or host buffering instead of a shared ring.
+ */
+export function rttCloseSharedRing(serialnumber, callback) {}
+
+/**
+ * Statistics for the host side buffer of one up channel.
+ * @typedef BufferStatistics
+ * @property {integer} channelIndex The up channel the buffer is filled from
+ * @property {integer} capacity The size of the buffer, in bytes
+ * @property {integer} used The amount of bytes waiting to be read
+ * @property {integer} highWaterMark The highest amount of bytes that has been waiting to be read
+ * @property {integer} bytesReceived The amount of bytes received from the device
+ * @property {integer} bytesDropped The amount of received bytes dropped because the buffer was full
+ * @property {integer} bytesRead The amount of bytes read from the buffer
+ * @property {integer} readLatency The time the oldest byte of the last read waited in the buffer, in microseconds
+ * @property {integer} maxReadLatency The longest time a byte has waited in the buffer, in microseconds
+ */
+
+/**
+ * Async function to get the statistics for the host side RTT buffers of a device. RTT must be started
+ * with a <tt>bufferSize</tt> in the {@link pc-nrfjprog-js.module:RTT~StartOptions|StartOptions}.
+ *
+ * @example
+ * nrfjprogjs.rttGetBufferStatistics(12345678, function(err, statistics) {
+ *      if (err) throw err;
+ *      statistics.forEach(function(channel) {
+ *          console.log(channel.channelIndex, channel.bytesDropped, channel.highWaterMark);
+ *      });
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to get the statistics for
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, Array of {@link pc-nrfjprog-js.module:RTT~BufferStatistics|BufferStatistics})
+ */
+export function rttGetBufferStatistics(serialnumber, callback) {}
+
+/**
+ * Statistics for the RTT session of one device.
+ * @typedef SessionStatistics
+ * @property {boolean} autoRecover Whether RTT is started again after read and write errors
+ * @property {integer} [controlBlockLocation] The cached location of the control block, if it is known
+ * @property {integer} upChannelCount The number of up channels, read again after every reconnect
+ * @property {integer} downChannelCount The number of down channels, read again after every reconnect
+ * @property {integer} reconnects The number of times RTT was started again after an error
+ * @property {integer} failedRecoveries The number of times RTT could not be started again
+ * @property {integer} downtime The time spent on all reconnects, in microseconds
+ * @property {integer} lastDowntime The time spent on the last reconnect, in microseconds
+ * @property {integer} lastError The nRFjprog error code that started the last recovery
+ */
+
+/**
+ * Async function to get the statistics for the RTT session of a device.
+ *
+ * @example
+ * nrfjprogjs.rttGetSessionStatistics(12345678, function(err, statistics) {
+ *      if (err) throw err;
+ *      console.log(statistics.reconnects, statistics.downtime);
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to get the statistics for
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect two parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, {@link pc-nrfjprog-js.module:RTT~SessionStatistics|SessionStatistics})
+ */
+export function rttGetSessionStatistics(serialnumber, callback) {}
+
+/**
+ * Options for an RTT write queue. Queued data is written in writes of up to <tt>maxWriteLength</tt> bytes.
+ * While the target has no room for more data, the write is retried after <tt>minRetryInterval</tt> milliseconds,
+ * and the interval doubles for every retry up to <tt>maxRetryInterval</tt>.
+ * @typedef WriteQueueOptions
+ * @property {integer} [highWaterMark=65536] The amount of bytes queued for a channel before backpressure is applied
+ * @property {integer} [maxWriteLength=1024] The max amount of bytes to write to a channel in one write
+ * @property {integer} [minRetryInterval=1] The shortest time between two retries, in milliseconds
+ * @property {integer} [maxRetryInterval=50] The longest time between two retries, in milliseconds
+ */
+
+/**
+ * <p>Async function to open a write queue for the RTT down channels of a device.</p>
+ *
+ * <p>Data queued with <tt>rttQueueWrite</tt> is written in the background until the target
+ * has accepted all of it. Small writes are combined into larger ones. RTT must be started with
+ * <tt>rttStart</tt> first. There may be one write queue per device, and it is closed with
+ * <tt>rttCloseWriteQueue</tt> or <tt>rttStop</tt>. Data that is not written yet is then discarded.</p>
+ *
+ * <p>When the data queued for a channel has grown above the high water mark, <tt>eventCallback</tt> is
+ * called with the channel index once all of it has been written. If writing fails, <tt>eventCallback</tt>
+ * is called with an {@link pc-nrfjprog-js.module:RTT~Error|Error} and the write queue stops.</p>
+ *
+ * @example
+ * nrfjprogjs.rttOpenWriteQueue(12345678, {}, function(err, channelIndex) {
+ *      if (err) throw err;
+ *      console.log('Channel', channelIndex, 'has drained');
+ * }, function(err) {
+ *      if (err) console.error('Could not open the write queue');
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to write RTT on
+ * @param {WriteQueueOptions} writeQueueOptions A plain object containing options about how to write the queued data
+ * @param {Function} eventCallback A callback function called when a channel has drained or writing failed.
+ *   It shall expect two parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, integer)
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ */
+export function rttOpenWriteQueue(serialnumber, writeQueueOptions, eventCallback, callback) {}
+
+/**
+ * Async function to close the RTT write queue of a device. Data that is not written yet is discarded.
+ *
+ * @example
+ * nrfjprogjs.rttCloseWriteQueue(12345678, function(err) {
+ *     if (err) console.error('Closing the write queue failed');
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to close the write queue on
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect one parameter: ({@link pc-nrfjprog-js.module:RTT~Error|Error})
+ */
+export function rttCloseWriteQueue(serialnumber, callback) {}
+
+/**
+ * <p>Async function to queue data for a down channel on the device. The data is always queued. If the
+ * queue for the channel has grown above the high water mark, the second parameter of the callback is
+ * <tt>false</tt>, and no more data should be queued until <tt>eventCallback</tt> of
+ * <tt>rttOpenWriteQueue</tt> reports that the channel has drained.</p>
+ *
+ * @example
+ * nrfjprogjs.rttQueueWrite(12345678, 0, 'Some data to write', function(err, belowHighWaterMark, queuedLength) {
+ *      if (err) throw err;
+ *      if (!belowHighWaterMark) console.log('Wait for drain, queued bytes:', queuedLength);
+ * });
+ *
+ * @param {integer} serialNumber The serial number of the device to write RTT on
+ * @param {integer} channelIndex The RTT down channel index to write to
+ * @param {string|integer[]} data The data to send
+ * @param {Function} callback A callback function to handle the async response.
+ *   It shall expect three parameters: ({@link pc-nrfjprog-js.module:RTT~Error|Error}, boolean, integer)
+ */
+export function rttQueueWrite(serialnumber, channelIndex, data, callback) {}
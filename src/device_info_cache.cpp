@@ -0,0 +1,204 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "device_info_cache.h"
+
+#include <algorithm>
+
+bool DeviceInfoCache::getDeviceInfo(const uint32_t serialNumber, const coprocessor_t coProcessor,
+                                    device_info_t & deviceInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    const auto entry = entries.find(serialNumber);
+
+    if (entry == entries.end())
+    {
+        return false;
+    }
+
+    const auto cached = entry->second.deviceInfo.find(coProcessor);
+
+    if (cached == entry->second.deviceInfo.end())
+    {
+        return false;
+    }
+
+    deviceInfo = cached->second;
+    return true;
+}
+
+bool DeviceInfoCache::getProbeInfo(const uint32_t serialNumber, probe_info_t & probeInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    const auto entry = entries.find(serialNumber);
+
+    if (entry == entries.end() || !entry->second.hasProbeInfo)
+    {
+        return false;
+    }
+
+    probeInfo = entry->second.probeInfo;
+    return true;
+}
+
+bool DeviceInfoCache::getLibraryInfo(const uint32_t serialNumber, library_info_t & libraryInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    const auto entry = entries.find(serialNumber);
+
+    if (entry == entries.end() || !entry->second.hasLibraryInfo)
+    {
+        return false;
+    }
+
+    libraryInfo = entry->second.libraryInfo;
+    return true;
+}
+
+void DeviceInfoCache::storeDeviceInfo(const uint32_t serialNumber, const coprocessor_t coProcessor,
+                                      const device_info_t & deviceInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    entries[serialNumber].deviceInfo[coProcessor] = deviceInfo;
+}
+
+void DeviceInfoCache::storeProbeInfo(const uint32_t serialNumber, const probe_info_t & probeInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto & entry       = entries[serialNumber];
+    entry.hasProbeInfo = true;
+    entry.probeInfo    = probeInfo;
+}
+
+void DeviceInfoCache::storeLibraryInfo(const uint32_t serialNumber, const library_info_t & libraryInfo)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto & entry         = entries[serialNumber];
+    entry.hasLibraryInfo = true;
+    entry.libraryInfo    = libraryInfo;
+}
+
+bool DeviceInfoCache::get(const uint32_t serialNumber, const enumeration_fields_t fields,
+                          ProbeEnumerationResult & result)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    const auto entry = entries.find(serialNumber);
+
+    if (entry == entries.end() || !entry->second.hasProbeInfo || !entry->second.hasLibraryInfo)
+    {
+        return false;
+    }
+
+    const auto deviceInfo = entry->second.deviceInfo.find(CP_APPLICATION);
+
+    if (fields == ENUMERATE_ALL_INFO)
+    {
+        if (deviceInfo == entry->second.deviceInfo.end())
+        {
+            return false;
+        }
+
+        result.deviceInfo = deviceInfo->second;
+    }
+
+    result.serialNumber = serialNumber;
+    result.fields       = fields;
+    result.probeInfo    = entry->second.probeInfo;
+    result.libraryInfo  = entry->second.libraryInfo;
+    result.error        = SUCCESS;
+    result.failedStep   = nullptr;
+    result.duration     = std::chrono::microseconds(0);
+    result.cached       = true;
+
+    return true;
+}
+
+void DeviceInfoCache::store(const ProbeEnumerationResult & result)
+{
+    // A partial result may be missing any of the information, so only complete results are kept
+    if (result.error != SUCCESS || result.fields == ENUMERATE_SERIAL_NUMBERS)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto & entry         = entries[result.serialNumber];
+    entry.hasProbeInfo   = true;
+    entry.probeInfo      = result.probeInfo;
+    entry.hasLibraryInfo = true;
+    entry.libraryInfo    = result.libraryInfo;
+
+    if (result.fields == ENUMERATE_ALL_INFO)
+    {
+        entry.deviceInfo[CP_APPLICATION] = result.deviceInfo;
+    }
+}
+
+void DeviceInfoCache::invalidate(const uint32_t serialNumber)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    entries.erase(serialNumber);
+}
+
+void DeviceInfoCache::invalidateAll()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+void DeviceInfoCache::retain(const std::vector<uint32_t> & serialNumbers)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (auto entry = entries.begin(); entry != entries.end();)
+    {
+        if (std::find(serialNumbers.begin(), serialNumbers.end(), entry->first) == serialNumbers.end())
+        {
+            entry = entries.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+}
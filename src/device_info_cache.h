@@ -0,0 +1,88 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DEVICE_INFO_CACHE_H
+#define DEVICE_INFO_CACHE_H
+
+#include "highlevel_common.h"
+#include "probe_enumeration.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// The device, probe and library information per serial number. This hardly ever
+// changes, so it is kept until the device is recovered or programmed, the probe
+// is disconnected, or the cache is invalidated from JS. The device information is
+// kept per coprocessor, the probe and library information is the same for all.
+class DeviceInfoCache
+{
+  public:
+    bool getDeviceInfo(uint32_t serialNumber, coprocessor_t coProcessor, device_info_t & deviceInfo);
+    bool getProbeInfo(uint32_t serialNumber, probe_info_t & probeInfo);
+    bool getLibraryInfo(uint32_t serialNumber, library_info_t & libraryInfo);
+
+    void storeDeviceInfo(uint32_t serialNumber, coprocessor_t coProcessor, const device_info_t & deviceInfo);
+    void storeProbeInfo(uint32_t serialNumber, const probe_info_t & probeInfo);
+    void storeLibraryInfo(uint32_t serialNumber, const library_info_t & libraryInfo);
+
+    // For enumeration, which reads the selected information of the application coprocessor
+    bool get(uint32_t serialNumber, enumeration_fields_t fields, ProbeEnumerationResult & result);
+    void store(const ProbeEnumerationResult & result);
+
+    void invalidate(uint32_t serialNumber);
+    void invalidateAll();
+
+    // Invalidates all serial numbers that are not in the list of connected probes
+    void retain(const std::vector<uint32_t> & serialNumbers);
+
+  private:
+    struct Entry
+    {
+        std::map<coprocessor_t, device_info_t> deviceInfo;
+        bool hasProbeInfo{false};
+        probe_info_t probeInfo;
+        bool hasLibraryInfo{false};
+        library_info_t libraryInfo;
+    };
+
+    std::mutex mutex;
+    std::map<uint32_t, Entry> entries;
+};
+
+#endif // DEVICE_INFO_CACHE_H
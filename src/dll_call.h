@@ -0,0 +1,94 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DLL_CALL_H
+#define DLL_CALL_H
+
+#include "highlevelnrfjprogdll.h"
+
+#include "library_call_statistics.h"
+#include "operation_trace.h"
+#include "throughput_counters.h"
+
+// Calls a function of the nrfjprog library, counts the call and how long it took, and records it
+// in the trace when the trace is started:
+// DLL_CALL(NRFJPROG_read, probe, address, data, length)
+#define DLL_CALL(function, ...) dllCall(#function, [&]() { return function(__VA_ARGS__); })
+
+// The same for a call that moves data to or from the probe, which also counts the bytes when the
+// call succeeds. The bytes are evaluated after the call, so they can be an output of it:
+// DLL_TRANSFER(THROUGHPUT_RTT_UP, readLength, NRFJPROG_rtt_read, probe, channel, data, length, &readLength)
+#define DLL_TRANSFER(direction, bytes, function, ...)                                                                  \
+    dllTransfer(direction, [&]() -> uint64_t { return (bytes); }, #function, [&]() { return function(__VA_ARGS__); })
+
+template <typename Function>
+auto timedDllCall(const char * name, Function && function, std::chrono::microseconds & duration)
+    -> decltype(function())
+{
+    const auto start  = OperationTrace::clock::now();
+    const auto result = function();
+    const auto end    = OperationTrace::clock::now();
+
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    LibraryCallStatistics::record(name, duration, static_cast<int32_t>(result));
+    OperationTrace::dllCall(name, start, end, static_cast<int32_t>(result));
+
+    return result;
+}
+
+template <typename Function> auto dllCall(const char * name, Function && function) -> decltype(function())
+{
+    std::chrono::microseconds duration;
+    return timedDllCall(name, function, duration);
+}
+
+template <typename Bytes, typename Function>
+auto dllTransfer(const throughput_direction_t direction, Bytes && bytes, const char * name, Function && function)
+    -> decltype(function())
+{
+    std::chrono::microseconds duration;
+    const auto result = timedDllCall(name, function, duration);
+
+    if (result == SUCCESS)
+    {
+        ThroughputCounters::record(direction, bytes(), duration);
+    }
+
+    return result;
+}
+
+#endif // DLL_CALL_H
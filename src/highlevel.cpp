@@ -36,36 +36,62 @@
 
 #include "highlevel.h"
 
+#include <atomic>
 #include <mutex>
 #include <queue>
 #include <sstream>
 #include <thread>
 #include <vector>
 
+#include "device_info_cache.h"
+#include "dll_call.h"
+#include "log_ring.h"
+#include "log_subscriber.h"
 #include "highlevel_batons.h"
 #include "highlevel_common.h"
 #include "highlevel_helpers.h"
+#include "operation_timing.h"
+#include "operation_trace.h"
+#include "probe_enumeration.h"
+#include "probe_health.h"
+#include "probe_watcher.h"
+#include "rtt_controlblock.h"
 
 #include "utility/conversion.h"
 #include "utility/errormessage.h"
 #include "utility/utility.h"
 
-constexpr int MAX_SERIAL_NUMBERS = 100;
+constexpr uint32_t INITIAL_SERIAL_NUMBERS    = 100;
+constexpr uint32_t MAX_PARALLEL_ENUMERATIONS = 32;
+constexpr uint64_t MAX_RTT_READ_MANY_LENGTH  = 16 * 1024 * 1024;
 
 struct HighLevelStaticPrivate
 {
     bool loaded{false};
-    std::string logMessage;
-    std::timed_mutex logMutex;
     std::unique_ptr<Nan::Callback> jsProgressCallback;
     std::unique_ptr<uv_async_t> progressEvent;
     std::mutex progressProcessMutex;
     std::queue<std::string> progressProcess;
-    std::chrono::high_resolution_clock::time_point rttStartTime{};
 
     std::map<uint32_t, Probe_handle_t> openProbeMap{};
     std::mutex openProbeMapMutex;
 
+    DeviceInfoCache deviceInfoCache;
+    OperationStatistics operationStatistics;
+    // Whether callbacks are passed the timing of the function as an extra parameter
+    std::atomic<bool> timingEnabled{false};
+
+    // Only accessed while holding the execution mutex
+    std::unique_ptr<ProbeWatcher> probeWatcher;
+
+    // Started and stopped while holding the execution mutex, read without it
+    std::unique_ptr<ProbeHealthMonitor> healthMonitor;
+    std::mutex healthMonitorMutex;
+
+    // Started and stopped without waiting for other functions
+    std::unique_ptr<LogSubscriber> logSubscriber;
+    std::mutex logSubscriberMutex;
+
     static inline Nan::Persistent<v8::Function> & constructor()
     {
         static Nan::Persistent<v8::Function> my_constructor;
@@ -119,6 +145,59 @@ struct HighLevelStaticPrivate
         return getProbe(serialNumber) != nullptr;
     }
 
+    std::vector<uint32_t> getOpenSerialNumbers()
+    {
+        std::unique_lock<std::mutex> lock(openProbeMapMutex);
+        std::vector<uint32_t> serialNumbers;
+
+        for (const auto & entry : openProbeMap)
+        {
+            serialNumbers.push_back(entry.first);
+        }
+
+        return serialNumbers;
+    }
+
+    std::map<uint32_t, std::shared_ptr<RttSession>> rttSessionMap{};
+    std::mutex rttSessionMapMutex;
+
+    void registerRttSession(const std::shared_ptr<RttSession> & session)
+    {
+        std::unique_lock<std::mutex> lock(rttSessionMapMutex);
+        rttSessionMap[session->getSerialNumber()] = session;
+    }
+
+    std::shared_ptr<RttSession> getRttSession(const uint32_t serialNumber)
+    {
+        std::unique_lock<std::mutex> lock(rttSessionMapMutex);
+        const auto it = rttSessionMap.find(serialNumber);
+        if (it != rttSessionMap.end())
+        {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<RttSession> unregisterRttSession(const Probe_handle_t probe)
+    {
+        std::unique_lock<std::mutex> lock(rttSessionMapMutex);
+        const auto it = std::find_if(
+            rttSessionMap.begin(),
+            rttSessionMap.end(),
+            [probe](const std::pair<const uint32_t, std::shared_ptr<RttSession>> & v) {
+                return v.second->getProbe() == probe;
+            }
+        );
+        if (it == rttSessionMap.end())
+        {
+            return nullptr;
+        }
+
+        auto session = it->second;
+        rttSessionMap.erase(it);
+        return session;
+    }
+
     const std::vector<coprocessor_t> coProcessors{ CP_APPLICATION, CP_NETWORK };
 };
 
@@ -159,7 +238,6 @@ HighLevel::HighLevel()
 {
     static HighLevelStaticPrivate highLevelStaticPrivate;
     pHighlvlStatic = &highLevelStaticPrivate;
-    resetLog();
 
     NRFJPROG_dll_open(nullptr, &HighLevel::log);
 }
@@ -170,11 +248,10 @@ void HighLevel::CallFunction(Nan::NAN_METHOD_ARGS_TYPE info,
                              const return_function_t & ret,
                              const bool hasSerialNumber)
 {
-    // This is a check that there exists a parse- and execute function, both of which are
-    // needed to parse arguments and execute the function.
+    // This is a check that there exists a parse function, which is needed to parse arguments.
     // If this shows up in production, it is due to missing functions in the relevant
     // NAN_METHOD defining the functions.
-    if (parse == nullptr || execute == nullptr)
+    if (parse == nullptr)
     {
         auto message = ErrorMessage::getErrorMessage(
             errorcode_t::CouldNotCallFunction, nrfjprog_js_err_map,
@@ -183,7 +260,8 @@ void HighLevel::CallFunction(Nan::NAN_METHOD_ARGS_TYPE info,
         return;
     }
 
-    resetLog();
+    const auto parseStart = OperationTrace::clock::now();
+    const auto logStart   = LogRing::nextSequence();
 
     auto argumentCount = 0;
     std::unique_ptr<Baton> baton;
@@ -260,6 +338,16 @@ void HighLevel::CallFunction(Nan::NAN_METHOD_ARGS_TYPE info,
         return;
     }
 
+    // Without an execute function, the unlocked function does all the work
+    if (execute == nullptr && !baton->unlockedFunction)
+    {
+        const auto message = ErrorMessage::getErrorMessage(
+            errorcode_t::CouldNotCallFunction, nrfjprog_js_err_map,
+            std::string("One or more of the parse, or execute functions is missing for this function"));
+        Nan::ThrowError(message);
+        return;
+    }
+
     // This is a check that there exists a returnfunction when there are more returns
     // than just err. If this shows up in production, it is due to missing return function
     if (ret == nullptr && baton->returnParameterCount > 0)
@@ -277,6 +365,16 @@ void HighLevel::CallFunction(Nan::NAN_METHOD_ARGS_TYPE info,
     baton->returnFunction  = ret;
     baton->serialNumber    = serialNumber;
     baton->coProcessor     = coProcessor;
+    baton->logStart        = logStart;
+
+    baton->timing.queue();
+
+    if (OperationTrace::isStarted())
+    {
+        baton->traceId = OperationTrace::nextId();
+        OperationTrace::complete(
+            "parse ", baton->name, "parse", OperationTrace::JS_TRACK, parseStart, OperationTrace::clock::now());
+    }
 
     uv_queue_work(
         uv_default_loop(), baton->req.get(), ExecuteFunction, reinterpret_cast<uv_after_work_cb>(ReturnFunction));
@@ -288,15 +386,64 @@ void HighLevel::ExecuteFunction(uv_work_t * req)
 {
     auto baton = static_cast<Baton *>(req->data);
 
+    const auto executeStart = OperationTrace::clock::now();
+    const auto track        = OperationTrace::laneTrack(baton->serialNumber);
+    OperationTrace::TrackScope trackScope(track);
+
+    ++baton->timing.executions;
+    baton->timing.startPhase();
+    baton->timing.queueWait +=
+        std::chrono::duration_cast<std::chrono::microseconds>(executeStart - baton->timing.queued);
+
+    OperationTrace::wait("queue wait ", baton->name, baton->traceId, track, baton->timing.queued, executeStart);
+
+    const auto endLockWait = [baton, track, executeStart]() {
+        baton->timing.endPhase(baton->timing.lockWait);
+        OperationTrace::wait(
+            "lock wait ", baton->name, baton->traceId, track, executeStart, OperationTrace::clock::now());
+    };
+
     std::unique_lock<std::timed_mutex> lock(Baton::executionMutex, std::defer_lock);
+    std::unique_lock<std::timed_mutex> laneLock;
 
-    if (!lock.try_lock_for(std::chrono::seconds(10)))
+    // Functions that only touch state with its own locking need neither the execution mutex nor the probe
+    if (baton->unlockedFunction && (baton->unlockedFunction(baton) || !baton->executeFunction))
+    {
+        return;
+    }
+
+    baton->session = baton->serialNumber != 0 ? pHighlvlStatic->getRttSession(baton->serialNumber) : nullptr;
+
+    // RTT functions on a probe with an open session only wait for that probe
+    const auto sessionLaneOnly = baton->runsOnSessionLane && baton->session;
+
+    if (!sessionLaneOnly && !lock.try_lock_for(std::chrono::seconds(10)))
     {
+        endLockWait();
         baton->result = CouldNotExecuteDueToLoad;
         return;
     }
 
-    if (pHighlvlStatic->jsProgressCallback)
+    if (baton->session)
+    {
+        laneLock = std::unique_lock<std::timed_mutex>(baton->session->laneMutex, std::defer_lock);
+
+        if (!laneLock.try_lock_for(std::chrono::seconds(10)))
+        {
+            endLockWait();
+            baton->result = CouldNotExecuteDueToLoad;
+            return;
+        }
+    }
+
+    endLockWait();
+
+    OperationTrace::Span executeSpan("", baton->name, "execute", track);
+
+    // The progress callback belongs to the function holding the global execution mutex
+    const auto reportsProgress = !sessionLaneOnly && pHighlvlStatic->jsProgressCallback;
+
+    if (reportsProgress)
     {
         pHighlvlStatic->progressEvent = std::make_unique<uv_async_t>();
         uv_async_init(uv_default_loop(), pHighlvlStatic->progressEvent.get(), sendProgress);
@@ -314,73 +461,91 @@ void HighLevel::ExecuteFunction(uv_work_t * req)
         else if (baton->probeType == DFU_PROBE)
         {
             // TODO: do not store in pHighlvlStatic
-            initError = NRFJPROG_dfu_init(&(baton->probe),
-                                          &HighLevel::progressCallback,
-                                          &HighLevel::log,
-                                          baton->serialNumber,
-                                          CP_MODEM,
-                                          nullptr);
+            initError = DLL_CALL(NRFJPROG_dfu_init,
+                                 &(baton->probe),
+                                 &HighLevel::progressCallback,
+                                 &HighLevel::log,
+                                 baton->serialNumber,
+                                 CP_MODEM,
+                                 nullptr);
         }
         else if (baton->probeType == MCUBOOT_PROBE)
         {
             const auto baton2 = dynamic_cast<ProgramMcuBootDFUBaton *>(baton);
 
-            initError = NRFJPROG_mcuboot_dfu_init(&(baton->probe),
-                                                  &HighLevel::progressCallback,
-                                                  &HighLevel::log,
-                                                  baton2->uart.c_str(),
-                                                  baton2->baudRate,
-                                                  baton2->responseTimeout);
+            initError = DLL_CALL(NRFJPROG_mcuboot_dfu_init,
+                                 &(baton->probe),
+                                 &HighLevel::progressCallback,
+                                 &HighLevel::log,
+                                 baton2->uart.c_str(),
+                                 baton2->baudRate,
+                                 baton2->responseTimeout);
         }
         else if (baton->probeType == MODEMUARTDFU_PROBE)
         {
             const auto baton2 = dynamic_cast<ProgramModemUartDFUBaton *>(baton);
 
-            initError = NRFJPROG_modemdfu_dfu_serial_init(&(baton->probe),
-                                                          &HighLevel::progressCallback,
-                                                          &HighLevel::log,
-                                                          baton2->uart.c_str(),
-                                                          baton2->baudRate,
-                                                          baton2->responseTimeout);
+            initError = DLL_CALL(NRFJPROG_modemdfu_dfu_serial_init,
+                                 &(baton->probe),
+                                 &HighLevel::progressCallback,
+                                 &HighLevel::log,
+                                 baton2->uart.c_str(),
+                                 baton2->baudRate,
+                                 baton2->responseTimeout);
         }
         else
         {
-            initError = NRFJPROG_probe_init(
-                &(baton->probe), &HighLevel::progressCallback, &HighLevel::log, baton->serialNumber, nullptr);
+            initError = DLL_CALL(NRFJPROG_probe_init,
+                                 &(baton->probe),
+                                 &HighLevel::progressCallback,
+                                 &HighLevel::log,
+                                 baton->serialNumber,
+                                 nullptr);
 
             if (initError == SUCCESS && baton->coProcessor != CP_APPLICATION)
             {
-                initError = NRFJPROG_probe_set_coprocessor(baton->probe, baton->coProcessor);
+                initError = DLL_CALL(NRFJPROG_probe_set_coprocessor, baton->probe, baton->coProcessor);
             }
         }
 
         if (initError != SUCCESS)
         {
+            // The probe may have been disconnected, or replaced by another one with the same serial number
+            pHighlvlStatic->deviceInfoCache.invalidate(baton->serialNumber);
+
+            baton->timing.endPhase(baton->timing.probeInit);
             baton->result        = errorcode_t::CouldNotOpenDevice;
             baton->lowlevelError = initError;
             return;
         }
     }
 
+    baton->timing.endPhase(baton->timing.probeInit);
+
     const auto executeError = baton->executeFunction(baton);
 
+    baton->timing.endPhase(baton->timing.operation);
+
     if (pHighlvlStatic->getProbe(baton->serialNumber) == nullptr)
     {
         if (baton->serialNumber != 0)
         {
             if (baton->probeType == DEBUG_PROBE && baton->cpuNeedsReset)
             {
-                const auto resetError = NRFJPROG_reset(baton->probe, RESET_SYSTEM);
+                const auto resetError = DLL_CALL(NRFJPROG_reset, baton->probe, RESET_SYSTEM);
 
                 if (resetError != SUCCESS)
                 {
+                    baton->timing.endPhase(baton->timing.cleanup);
                     baton->result        = errorcode_t::CouldNotResetDevice;
                     baton->lowlevelError = resetError;
                     return;
                 }
             }
 
-            const auto uninitError = NRFJPROG_probe_uninit(&(baton->probe));
+            const auto uninitError = DLL_CALL(NRFJPROG_probe_uninit, &(baton->probe));
+
+            baton->timing.endPhase(baton->timing.cleanup);
 
             if (uninitError != SUCCESS)
             {
@@ -397,7 +562,7 @@ void HighLevel::ExecuteFunction(uv_work_t * req)
         baton->lowlevelError = executeError;
     }
 
-    if (pHighlvlStatic->progressEvent)
+    if (reportsProgress && pHighlvlStatic->progressEvent)
     {
         const auto handle = reinterpret_cast<uv_handle_t *>(pHighlvlStatic->progressEvent.get());
 
@@ -407,19 +572,34 @@ void HighLevel::ExecuteFunction(uv_work_t * req)
 
 void HighLevel::ReturnFunction(uv_work_t * req)
 {
+    const auto pendingBaton = static_cast<Baton *>(req->data);
+
+    if (pendingBaton->result == errorcode_t::JsSuccess && pendingBaton->rescheduleDelay.count() > 0)
+    {
+        RescheduleFunction(pendingBaton);
+        return;
+    }
+
     Nan::HandleScope scope;
 
     std::unique_ptr<Baton> baton(static_cast<Baton *>(req->data));
     std::vector<v8::Local<v8::Value>> argv;
 
+    OperationTrace::Span returnSpan("return ", baton->name, "return", OperationTrace::JS_TRACK);
+
+    baton->timing.startPhase();
+
+    // The log of a function is only put together when it failed
     std::string msg;
 
+    if (baton->result != errorcode_t::JsSuccess)
     {
-        std::unique_lock<std::timed_mutex> lock(pHighlvlStatic->logMutex, std::defer_lock);
-
-        if (lock.try_lock_for(std::chrono::seconds(10)))
+        for (const auto & record : LogRing::copy(baton->logStart))
         {
-            msg = pHighlvlStatic->logMessage;
+            if (record.serialNumber == 0 || record.serialNumber == baton->serialNumber)
+            {
+                msg.append(record.message).append("\n");
+            }
         }
     }
 
@@ -445,37 +625,69 @@ void HighLevel::ReturnFunction(uv_work_t * req)
 
     pHighlvlStatic->jsProgressCallback.reset();
 
-    Nan::AsyncResource resource("pc-nrfjprog-js:callback");
-    baton->callback->Call(baton->returnParameterCount + 1, argv.data(), &resource);
-}
-
-void HighLevel::log(const char * msg)
-{
-    log(std::string(msg));
-}
+    baton->timing.endPhase(baton->timing.returnConversion);
+    baton->timing.finish();
 
-void HighLevel::log(const std::string & msg)
-{
-    std::unique_lock<std::timed_mutex> lock(pHighlvlStatic->logMutex, std::defer_lock);
+    pHighlvlStatic->operationStatistics.record(
+        baton->name, baton->serialNumber, baton->timing, baton->result != errorcode_t::JsSuccess);
 
-    if (!lock.try_lock_for(std::chrono::seconds(10)))
+    if (!pHighlvlStatic->timingEnabled)
     {
+        Nan::AsyncResource resource("pc-nrfjprog-js:callback");
+        baton->callback->Call(static_cast<int>(argv.size()), argv.data(), &resource);
         return;
     }
 
-    pHighlvlStatic->logMessage.append(msg + '\n');
+    // The timing comes right after the declared return parameters, for both success and error
+    const auto timingIndex = static_cast<size_t>(baton->returnParameterCount) + 1;
+
+    while (argv.size() < timingIndex)
+    {
+        argv.emplace_back(Nan::Undefined());
+    }
+
+    argv.resize(timingIndex);
+    argv.emplace_back(TimingInfo(baton->timing).ToJs());
+
+    Nan::AsyncResource resource("pc-nrfjprog-js:callback");
+    baton->callback->Call(static_cast<int>(argv.size()), argv.data(), &resource);
 }
 
-void HighLevel::resetLog()
+void HighLevel::RescheduleFunction(Baton * baton)
 {
-    std::unique_lock<std::timed_mutex> lock(pHighlvlStatic->logMutex, std::defer_lock);
+    auto timer  = new uv_timer_t();
+    timer->data = static_cast<void *>(baton);
+
+    const auto delay       = static_cast<uint64_t>(baton->rescheduleDelay.count());
+    baton->rescheduleDelay = std::chrono::milliseconds(0);
+
+    uv_timer_init(uv_default_loop(), timer);
+    uv_timer_start(
+        timer,
+        [](uv_timer_t * handle) {
+            auto timerBaton = static_cast<Baton *>(handle->data);
+            timerBaton->timing.queue();
+
+            uv_close(reinterpret_cast<uv_handle_t *>(handle),
+                     [](uv_handle_t * closeHandle) { delete reinterpret_cast<uv_timer_t *>(closeHandle); });
+
+            uv_queue_work(uv_default_loop(),
+                          timerBaton->req.get(),
+                          ExecuteFunction,
+                          reinterpret_cast<uv_after_work_cb>(ReturnFunction));
+        },
+        delay,
+        0);
+}
 
-    if (!lock.try_lock_for(std::chrono::seconds(10)))
-    {
-        return;
-    }
+void HighLevel::log(const char * msg)
+{
+    LogRing::add(LOG_LEVEL_DEBUG, msg);
+}
 
-    pHighlvlStatic->logMessage.clear();
+void HighLevel::log(const std::string & msg)
+{
+    LogRing::add(LOG_LEVEL_ERROR, msg);
 }
 
 void HighLevel::progressCallback(const char * process)
@@ -513,6 +725,8 @@ void HighLevel::sendProgress(uv_async_t * /*handle*/)
 
         argv[0] = progressObj;
 
+        OperationTrace::Span progressSpan("progress ", process, "progress", OperationTrace::JS_TRACK);
+
         Nan::AsyncResource resource("pc-nrfjprog-js:callback");
         pHighlvlStatic->jsProgressCallback->Call(1, static_cast<v8::Local<v8::Value> *>(argv), &resource);
     }
@@ -523,7 +737,29 @@ void HighLevel::init(v8::Local<v8::FunctionTemplate> target)
     Nan::SetPrototypeMethod(target, "getDllVersion", GetLibraryVersion); // Deprecated
     Nan::SetPrototypeMethod(target, "getLibraryVersion", GetLibraryVersion);
     Nan::SetPrototypeMethod(target, "getConnectedDevices", GetConnectedDevices);
+    Nan::SetPrototypeMethod(target, "discoverDevices", DiscoverDevices);
     Nan::SetPrototypeMethod(target, "getSerialNumbers", GetSerialNumbers);
+    Nan::SetPrototypeMethod(target, "invalidateDeviceInfo", InvalidateDeviceInfo);
+    Nan::SetPrototypeMethod(target, "startProbeWatcher", StartProbeWatcher);
+    Nan::SetPrototypeMethod(target, "stopProbeWatcher", StopProbeWatcher);
+    Nan::SetPrototypeMethod(target, "setSimulatedProbes", SetSimulatedProbes);
+    Nan::SetPrototypeMethod(target, "startHealthMonitor", StartHealthMonitor);
+    Nan::SetPrototypeMethod(target, "stopHealthMonitor", StopHealthMonitor);
+    Nan::SetPrototypeMethod(target, "getProbeHealth", GetProbeHealth);
+    Nan::SetPrototypeMethod(target, "getStats", GetStats);
+    Nan::SetPrototypeMethod(target, "resetStats", ResetStats);
+    Nan::SetPrototypeMethod(target, "setTimingEnabled", SetTimingEnabled);
+    Nan::SetPrototypeMethod(target, "getLibraryCallStats", GetLibraryCallStats);
+    Nan::SetPrototypeMethod(target, "resetLibraryCallStats", ResetLibraryCallStats);
+    Nan::SetPrototypeMethod(target, "getThroughputStats", GetThroughputStats);
+    Nan::SetPrototypeMethod(target, "resetThroughputStats", ResetThroughputStats);
+    Nan::SetPrototypeMethod(target, "setLogLevel", SetLogLevel);
+    Nan::SetPrototypeMethod(target, "getLog", GetLog);
+    Nan::SetPrototypeMethod(target, "subscribeLog", SubscribeLog);
+    Nan::SetPrototypeMethod(target, "unsubscribeLog", UnsubscribeLog);
+    Nan::SetPrototypeMethod(target, "startTrace", StartTrace);
+    Nan::SetPrototypeMethod(target, "stopTrace", StopTrace);
+    Nan::SetPrototypeMethod(target, "flushTrace", FlushTrace);
     Nan::SetPrototypeMethod(target, "getDeviceInfo", GetDeviceInfo);
     Nan::SetPrototypeMethod(target, "getProbeInfo", GetProbeInfo);
     Nan::SetPrototypeMethod(target, "getLibraryInfo", GetLibraryInfo);
@@ -548,6 +784,18 @@ void HighLevel::init(v8::Local<v8::FunctionTemplate> target)
     Nan::SetPrototypeMethod(target, "rttStop", RttStop);
     Nan::SetPrototypeMethod(target, "rttRead", RttRead);
     Nan::SetPrototypeMethod(target, "rttWrite", RttWrite);
+    Nan::SetPrototypeMethod(target, "rttReadMany", RttReadMany);
+    Nan::SetPrototypeMethod(target, "rttSubscribe", RttSubscribe);
+    Nan::SetPrototypeMethod(target, "rttUnsubscribe", RttUnsubscribe);
+    Nan::SetPrototypeMethod(target, "rttCapture", RttCapture);
+    Nan::SetPrototypeMethod(target, "rttStopCapture", RttStopCapture);
+    Nan::SetPrototypeMethod(target, "rttOpenSharedRing", RttOpenSharedRing);
+    Nan::SetPrototypeMethod(target, "rttCloseSharedRing", RttCloseSharedRing);
+    Nan::SetPrototypeMethod(target, "rttGetBufferStatistics", RttGetBufferStatistics);
+    Nan::SetPrototypeMethod(target, "rttGetSessionStatistics", RttGetSessionStatistics);
+    Nan::SetPrototypeMethod(target, "rttOpenWriteQueue", RttOpenWriteQueue);
+    Nan::SetPrototypeMethod(target, "rttCloseWriteQueue", RttCloseWriteQueue);
+    Nan::SetPrototypeMethod(target, "rttQueueWrite", RttQueueWrite);
 
     Nan::SetPrototypeMethod(target, "open", OpenDevice);
     Nan::SetPrototypeMethod(target, "close", CloseDevice);
@@ -653,6 +901,30 @@ void HighLevel::initConsts(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
     NODE_DEFINE_CONSTANT(target, INPUT_FORMAT_HEX_FILE);   // NOLINT(hicpp-signed-bitwise)
     NODE_DEFINE_CONSTANT(target, INPUT_FORMAT_HEX_STRING); // NOLINT(hicpp-signed-bitwise)
 
+    NODE_DEFINE_CONSTANT(target, RTT_FRAMING_NONE);          // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_FRAMING_LINE);          // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_FRAMING_LENGTH_PREFIX); // NOLINT(hicpp-signed-bitwise)
+
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_WRITE_INDEX);  // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_READ_INDEX);   // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_DROPPED);      // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_STATE);        // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_HEADER_WORDS); // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_RUNNING);      // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_STOPPED);      // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, RTT_SHARED_RING_FAILED);       // NOLINT(hicpp-signed-bitwise)
+
+    NODE_DEFINE_CONSTANT(target, ENUMERATE_SERIAL_NUMBERS); // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, ENUMERATE_PROBE_INFO);     // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, ENUMERATE_ALL_INFO);       // NOLINT(hicpp-signed-bitwise)
+
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_TRACE);   // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_DEBUG);   // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_INFO);    // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_WARNING); // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_ERROR);   // NOLINT(hicpp-signed-bitwise)
+    NODE_DEFINE_CONSTANT(target, LOG_LEVEL_NONE);    // NOLINT(hicpp-signed-bitwise)
+
     NODE_DEFINE_CONSTANT(target, UP_DIRECTION);   // NOLINT(hicpp-signed-bitwise)
     NODE_DEFINE_CONSTANT(target, DOWN_DIRECTION); // NOLINT(hicpp-signed-bitwise)
 }
@@ -662,49 +934,237 @@ nrfjprogdll_err_t HighLevel::rttCleanup(Probe_handle_t probe)
     nrfjprogdll_err_t status = SUCCESS;
     bool started;
 
-    NRFJPROG_is_rtt_started(probe, &started);
+    // The reader and writer threads must be gone before the probe can be uninitialized
+    const auto session = pHighlvlStatic->unregisterRttSession(probe);
+    if (session)
+    {
+        session->releaseReader();
+        session->releaseWriter();
+    }
+
+    DLL_CALL(NRFJPROG_is_rtt_started, probe, &started);
 
     if (started)
     {
-        status = NRFJPROG_rtt_stop(probe);
+        status = DLL_CALL(NRFJPROG_rtt_stop, probe);
     }
 
     pHighlvlStatic->unregisterProbe(probe);
     return status;
 }
 
-nrfjprogdll_err_t HighLevel::waitForControlBlock(const Probe_handle_t probe, bool & isControlBlockFound)
+bool HighLevel::interruptRttRecovery(Baton * baton)
 {
-    while (true)
+    const auto session = pHighlvlStatic->getRttSession(baton->serialNumber);
+
+    if (session)
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        auto controlBlockFound = false;
+        session->interruptRecovery();
+    }
+
+    // The function itself still runs on the lane
+    return false;
+}
 
-        const auto status = NRFJPROG_rtt_is_control_block_found(probe, &controlBlockFound);
+bool HighLevel::stopRttRecovery(Baton * baton)
+{
+    const auto session = pHighlvlStatic->getRttSession(baton->serialNumber);
 
-        if (status != SUCCESS)
+    if (session)
+    {
+        session->stopRecovery();
+    }
+
+    return false;
+}
+
+bool HighLevel::lockRttLane(const uint32_t serialNumber, std::unique_lock<std::timed_mutex> & laneLock)
+{
+    // RTT functions of an open session run on its lane, not under the execution mutex
+    const auto session = pHighlvlStatic->getRttSession(serialNumber);
+
+    if (!session)
+    {
+        return true;
+    }
+
+    laneLock = std::unique_lock<std::timed_mutex>(session->laneMutex, std::defer_lock);
+    return laneLock.try_lock_for(std::chrono::seconds(10));
+}
+
+void HighLevel::forgetProbe(const uint32_t serialNumber)
+{
+    pHighlvlStatic->deviceInfoCache.invalidate(serialNumber);
+
+    auto probe = pHighlvlStatic->getProbe(serialNumber);
+    if (probe == nullptr)
+    {
+        return;
+    }
+
+    std::unique_lock<std::timed_mutex> laneLock;
+
+    if (!lockRttLane(serialNumber, laneLock))
+    {
+        return;
+    }
+
+    // The probe is gone, so errors from stopping RTT and closing it are expected
+    (void)rttCleanup(probe);
+    pHighlvlStatic->unregisterProbe(serialNumber);
+    (void)DLL_CALL(NRFJPROG_probe_uninit, &probe);
+}
+
+nrfjprogdll_err_t HighLevel::checkProbeHealth(const uint32_t serialNumber, std::chrono::microseconds & latency)
+{
+    OperationTrace::TrackScope trackScope(OperationTrace::laneTrack(serialNumber));
+
+    std::unique_lock<std::timed_mutex> laneLock;
+
+    if (!lockRttLane(serialNumber, laneLock))
+    {
+        return INVALID_OPERATION;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    probe_info_t probeInfo;
+    nrfjprogdll_err_t status;
+
+    // An open probe is asked directly, any other probe has to be connected to first
+    auto probe = pHighlvlStatic->getProbe(serialNumber);
+
+    if (probe != nullptr)
+    {
+        status = DLL_CALL(NRFJPROG_get_probe_info, probe, &probeInfo);
+    }
+    else
+    {
+        // The progress callback belongs to the function holding the execution mutex, so there is none here
+        status = DLL_CALL(NRFJPROG_probe_init, &probe, nullptr, &HighLevel::log, serialNumber, nullptr);
+
+        if (status == SUCCESS)
         {
-            isControlBlockFound = false;
-            rttCleanup(probe);
-            return status;
+            status = DLL_CALL(NRFJPROG_get_probe_info, probe, &probeInfo);
+            DLL_CALL(NRFJPROG_probe_uninit, &probe);
         }
+    }
+
+    latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
 
-        if (controlBlockFound)
+    return status;
+}
+
+nrfjprogdll_err_t HighLevel::pollControlBlock(RTTStartBaton * baton)
+{
+    auto controlBlockFound = false;
+
+    const auto status = DLL_CALL(NRFJPROG_rtt_is_control_block_found, baton->probe, &controlBlockFound);
+
+    if (status != SUCCESS)
+    {
+        baton->foundControlBlock = false;
+        rttCleanup(baton->probe);
+        return status;
+    }
+
+    const auto now = std::chrono::high_resolution_clock::now();
+
+    if (controlBlockFound)
+    {
+        baton->foundControlBlock = true;
+        baton->searchEndTime     = now;
+
+        const auto channelStatus = getChannelInformation(baton, baton->foundChannelInformation);
+
+        if (channelStatus != SUCCESS)
         {
-            isControlBlockFound = true;
-            return SUCCESS;
+            return channelStatus;
         }
 
-        auto attemptedStartupTime = std::chrono::high_resolution_clock::now();
+        baton->session->setChannelInfo(baton->upChannelInfo, baton->downChannelInfo);
 
-        if (std::chrono::duration_cast<std::chrono::seconds>(attemptedStartupTime - pHighlvlStatic->rttStartTime)
-                .count() > 5)
+        if (baton->autoRecover)
+        {
+            const auto recoveryStatus = enableRecovery(baton);
+
+            if (recoveryStatus != SUCCESS)
+            {
+                return recoveryStatus;
+            }
+        }
+
+        if (baton->bufferSize == 0)
         {
-            isControlBlockFound = false;
-            rttCleanup(probe);
             return SUCCESS;
         }
+
+        return startBuffering(baton);
+    }
+
+    if (now - baton->searchStartTime >= baton->searchOptions.timeout)
+    {
+        baton->foundControlBlock = false;
+        rttCleanup(baton->probe);
+        return TIME_OUT;
+    }
+
+    // Poll again later, backing off while the firmware is still booting
+    baton->rescheduleDelay = baton->searchInterval;
+    baton->searchInterval  = std::min(baton->searchInterval * 2, baton->searchOptions.maxInterval);
+
+    return SUCCESS;
+}
+
+nrfjprogdll_err_t HighLevel::enableRecovery(RTTStartBaton * baton)
+{
+    auto hasAddress = baton->hasControlBlockLocation;
+    auto address    = baton->controlBlockLocation;
+
+    // The DLL does not tell where it found the control block, look it up once in data RAM
+    if (!hasAddress)
+    {
+        device_info_t deviceInfo;
+
+        auto status = DLL_CALL(NRFJPROG_get_device_info, baton->probe, &deviceInfo);
+
+        if (status == SUCCESS)
+        {
+            status = findRttControlBlock(
+                baton->probe, deviceInfo.data_ram_address, deviceInfo.ram_size, hasAddress, address);
+        }
+
+        if (status != SUCCESS)
+        {
+            rttCleanup(baton->probe);
+            return status;
+        }
+    }
+
+    // Without an address, every recovery searches for the control block again
+    baton->session->enableRecovery(hasAddress, address, baton->searchOptions);
+
+    return SUCCESS;
+}
+
+nrfjprogdll_err_t HighLevel::startBuffering(RTTStartBaton * baton)
+{
+    std::vector<uint32_t> channels;
+
+    for (uint32_t i = 0; i < baton->session->getUpChannelCount(); ++i)
+    {
+        channels.push_back(i);
+    }
+
+    auto reader = std::make_unique<RttReader>(channels, RttReaderOptions(), baton->bufferSize);
+
+    const auto status = baton->session->startReader(reader);
+
+    if (status != SUCCESS)
+    {
+        rttCleanup(baton->probe);
     }
+
+    return status;
 }
 
 nrfjprogdll_err_t HighLevel::getChannelInformation(RTTStartBaton * baton, bool & isChannelInformationAvailable)
@@ -712,7 +1172,8 @@ nrfjprogdll_err_t HighLevel::getChannelInformation(RTTStartBaton * baton, bool &
     uint32_t downChannelNumber;
     uint32_t upChannelNumber;
 
-    const auto countStatus = NRFJPROG_rtt_read_channel_count(baton->probe, &downChannelNumber, &upChannelNumber);
+    const auto countStatus =
+        DLL_CALL(NRFJPROG_rtt_read_channel_count, baton->probe, &downChannelNumber, &upChannelNumber);
 
     if (countStatus != SUCCESS)
     {
@@ -727,8 +1188,8 @@ nrfjprogdll_err_t HighLevel::getChannelInformation(RTTStartBaton * baton, bool &
         auto * pChannelName = static_cast<char *>(channelName);
         uint32_t channelSize;
 
-        const auto status =
-            NRFJPROG_rtt_read_channel_info(baton->probe, i, DOWN_DIRECTION, pChannelName, 32, &channelSize);
+        const auto status = DLL_CALL(
+            NRFJPROG_rtt_read_channel_info, baton->probe, i, DOWN_DIRECTION, pChannelName, 32, &channelSize);
         if (status != SUCCESS)
         {
             isChannelInformationAvailable = false;
@@ -746,8 +1207,8 @@ nrfjprogdll_err_t HighLevel::getChannelInformation(RTTStartBaton * baton, bool &
         auto * pChannelName = static_cast<char *>(channelName);
         uint32_t channelSize;
 
-        const auto status =
-            NRFJPROG_rtt_read_channel_info(baton->probe, i, UP_DIRECTION, pChannelName, 32, &channelSize);
+        const auto status = DLL_CALL(
+            NRFJPROG_rtt_read_channel_info, baton->probe, i, UP_DIRECTION, pChannelName, 32, &channelSize);
 
         if (status != SUCCESS)
         {
@@ -768,7 +1229,7 @@ nrfjprogdll_err_t HighLevel::getChannelInformation(RTTStartBaton * baton, bool &
 bool HighLevel::isRttStarted(Probe_handle_t probe)
 {
     bool started;
-    NRFJPROG_is_rtt_started(probe, &started);
+    DLL_CALL(NRFJPROG_is_rtt_started, probe, &started);
     return started;
 }
 
@@ -780,7 +1241,7 @@ NAN_METHOD(HighLevel::GetLibraryVersion)
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
         auto baton = dynamic_cast<GetLibraryVersionBaton *>(b);
-        return NRFJPROG_dll_version(&baton->major, &baton->minor, &baton->revision);
+        return DLL_CALL(NRFJPROG_dll_version, &baton->major, &baton->minor, &baton->revision);
     };
 
     const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
@@ -800,682 +1261,2120 @@ NAN_METHOD(HighLevel::GetLibraryVersion)
     CallFunction(info, p, e, r, false);
 }
 
-NAN_METHOD(HighLevel::GetConnectedDevices)
+bool HighLevel::listProbesLocked(Baton * baton, std::vector<uint32_t> & serialNumbers)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new GetConnectedDevicesBaton();
-    };
-
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<GetConnectedDevicesBaton *>(b);
-        uint32_t serialNumbers[MAX_SERIAL_NUMBERS];
-        uint32_t available = 0;
-        const nrfjprogdll_err_t error =
-            NRFJPROG_get_connected_probes(static_cast<uint32_t *>(serialNumbers), MAX_SERIAL_NUMBERS, &available);
+    std::unique_lock<std::timed_mutex> lock(Baton::executionMutex, std::defer_lock);
 
-        if (error != SUCCESS)
-        {
-            return error;
-        }
+    if (!lock.try_lock_for(std::chrono::seconds(10)))
+    {
+        baton->result = CouldNotExecuteDueToLoad;
+        return false;
+    }
 
-        for (uint32_t i = 0; i < available; i++)
-        {
-            Probe_handle_t getInfoProbe;
-            const nrfjprogdll_err_t initError = NRFJPROG_probe_init(
-                &getInfoProbe, &HighLevel::progressCallback, &HighLevel::log, serialNumbers[i], nullptr);
+    const auto error = listConnectedProbes(serialNumbers, INITIAL_SERIAL_NUMBERS);
 
-            device_info_t device_info;
-            probe_info_t probe_info;
-            library_info_t library_info;
+    if (error != SUCCESS)
+    {
+        baton->result        = errorcode_t::CouldNotCallFunction;
+        baton->lowlevelError = error;
+        return false;
+    }
 
-            if (initError == SUCCESS)
-            {
-                NRFJPROG_get_device_info(getInfoProbe, &device_info);
-                NRFJPROG_get_probe_info(getInfoProbe, &probe_info);
-                NRFJPROG_get_library_info(getInfoProbe, &library_info);
+    return true;
+}
 
-                NRFJPROG_probe_uninit(&getInfoProbe);
-            }
-            baton->probes.emplace_back(
-                std::make_unique<ProbeDetails>(serialNumbers[i], device_info, probe_info, library_info));
-        }
+std::vector<ProbeEnumerationResult>
+HighLevel::enumerateConnectedProbes(const std::vector<uint32_t> & connectedSerialNumbers,
+                                    const EnumerationOptions & options,
+                                    const std::function<void(const ProbeEnumerationResult &)> & onResult)
+{
+    // Information of probes that are gone must not be served when they come back
+    pHighlvlStatic->deviceInfoCache.retain(connectedSerialNumbers);
 
-        return SUCCESS;
-    };
+    // Only the probes that are asked for are read, the others are not even opened
+    const auto serialNumbers = options.apply(connectedSerialNumbers);
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        auto baton = dynamic_cast<GetConnectedDevicesBaton *>(b);
-        std::vector<v8::Local<v8::Value>> returnData;
+    std::vector<ProbeEnumerationResult> results(serialNumbers.size(), ProbeEnumerationResult{});
+    std::vector<uint32_t> uncachedSerialNumbers;
 
-        v8::Local<v8::Array> connectedDevices = Nan::New<v8::Array>();
-        int i                                 = 0;
-        for (auto & element : baton->probes)
+    for (size_t i = 0; i < serialNumbers.size(); ++i)
+    {
+        // Serial numbers alone are known without the cache
+        if (options.fields == ENUMERATE_SERIAL_NUMBERS ||
+            !pHighlvlStatic->deviceInfoCache.get(serialNumbers[i], options.fields, results[i]))
         {
-            Nan::Set(connectedDevices, Convert::toJsNumber(i), element->ToJs());
-            i++;
+            uncachedSerialNumbers.push_back(serialNumbers[i]);
         }
+        else if (onResult)
+        {
+            onResult(results[i]);
+        }
+    }
 
-        returnData.emplace_back(connectedDevices);
-
-        return returnData;
-    };
+    // The probes are independent, so they are all read at the same time. The progress callback
+    // belongs to the function holding the execution mutex, so there is none here.
+    const auto readResults = enumerateProbes(uncachedSerialNumbers,
+                                             options.fields,
+                                             MAX_PARALLEL_ENUMERATIONS,
+                                             nullptr,
+                                             &HighLevel::log,
+                                             &HighLevel::lockRttLane,
+                                             [&onResult](const ProbeEnumerationResult & result) {
+                                                 pHighlvlStatic->deviceInfoCache.store(result);
+
+                                                 if (onResult)
+                                                 {
+                                                     onResult(result);
+                                                 }
+                                             });
+
+    auto readResult = readResults.begin();
+
+    for (size_t i = 0; i < serialNumbers.size(); ++i)
+    {
+        if (!results[i].cached)
+        {
+            results[i] = *readResult++;
+        }
+    }
 
-    CallFunction(info, p, e, r, false);
+    return results;
 }
 
-NAN_METHOD(HighLevel::GetSerialNumbers)
+NAN_METHOD(HighLevel::GetConnectedDevices)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new GetSerialNumbersBaton();
-    };
-
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<GetSerialNumbersBaton *>(b);
-        uint32_t serialNumbers[MAX_SERIAL_NUMBERS];
-        uint32_t available = 0;
-        const nrfjprogdll_err_t error =
-            NRFJPROG_get_connected_probes(static_cast<uint32_t *>(serialNumbers), MAX_SERIAL_NUMBERS, &available);
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<GetConnectedDevicesBaton>();
 
-        if (error != SUCCESS)
+        // The options are optional, without them all information of all devices is read
+        if (parameters.Length() > argumentCount + 1)
         {
-            return error;
+            const auto enumerationOptions = Convert::getJsObject(parameters[argumentCount]);
+            baton->options                = EnumerationOptions(enumerationOptions);
+            ++argumentCount;
         }
 
-        for (uint32_t i = 0; i < available; ++i)
-        {
-            baton->serialNumbers.emplace_back(serialNumbers[i]);
-        }
+        // Only listing the probes takes the execution mutex, reading them would hold up every other function
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetConnectedDevicesBaton *>(b);
+            std::vector<uint32_t> serialNumbers;
 
-        return SUCCESS;
+            if (!listProbesLocked(baton, serialNumbers))
+            {
+                return true;
+            }
+
+            const auto results = enumerateConnectedProbes(serialNumbers, baton->options, nullptr);
+
+            for (const auto & result : results)
+            {
+                baton->probes.emplace_back(std::make_unique<ProbeDetails>(result));
+            }
+
+            return true;
+        };
+
+        return baton.release();
     };
 
     const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        auto baton = dynamic_cast<GetSerialNumbersBaton *>(b);
+        auto baton = dynamic_cast<GetConnectedDevicesBaton *>(b);
         std::vector<v8::Local<v8::Value>> returnData;
 
-        v8::Local<v8::Array> serialNumbers = Nan::New<v8::Array>();
-        int i                              = 0;
-        for (auto serialNumber : baton->serialNumbers)
+        v8::Local<v8::Array> connectedDevices = Nan::New<v8::Array>();
+        int i                                 = 0;
+        for (auto & element : baton->probes)
         {
-            Nan::Set(serialNumbers, Convert::toJsNumber(i), Convert::toJsNumber(serialNumber));
-            ++i;
+            Nan::Set(connectedDevices, Convert::toJsNumber(i), element->ToJs());
+            i++;
         }
 
-        returnData.emplace_back(serialNumbers);
+        returnData.emplace_back(connectedDevices);
 
         return returnData;
     };
 
-    CallFunction(info, p, e, r, false);
+    CallFunction(info, p, nullptr, r, false);
 }
 
-NAN_METHOD(HighLevel::GetProbeInfo)
+NAN_METHOD(HighLevel::DiscoverDevices)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new GetProbeInfoBaton();
-    };
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<DiscoverDevicesBaton>();
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<GetProbeInfoBaton *>(b);
-        return NRFJPROG_get_probe_info(b->probe, &baton->probeInfo);
-    };
+        // The options are optional, without them all information of all devices is read
+        if (parameters.Length() > argumentCount + 2)
+        {
+            const auto enumerationOptions = Convert::getJsObject(parameters[argumentCount]);
+            baton->options                = EnumerationOptions(enumerationOptions);
+            ++argumentCount;
+        }
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        const auto baton = dynamic_cast<GetProbeInfoBaton *>(b);
-        std::vector<v8::Local<v8::Value>> returnData;
+        baton->discovery = std::make_unique<ProbeDiscovery>(Convert::getCallbackFunction(parameters[argumentCount]));
+        ++argumentCount;
 
-        returnData.emplace_back(ProbeInfo(baton->probeInfo).ToJs());
+        // Only listing the probes takes the execution mutex, reading them would hold up every other function
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<DiscoverDevicesBaton *>(b);
+            std::vector<uint32_t> serialNumbers;
 
-        return returnData;
-    };
+            if (!listProbesLocked(baton, serialNumbers))
+            {
+                return true;
+            }
 
-    CallFunction(info, p, e, r, true);
-}
+            auto discovery = baton->discovery.get();
 
-NAN_METHOD(HighLevel::GetLibraryInfo)
-{
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new GetLibraryInfoBaton();
-    };
+            const auto results = enumerateConnectedProbes(
+                serialNumbers, baton->options, [discovery](const ProbeEnumerationResult & result) {
+                    discovery->push(result);
+                });
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<GetLibraryInfoBaton *>(b);
-        return NRFJPROG_get_library_info(b->probe, &baton->libraryInfo);
+            baton->deviceCount = static_cast<uint32_t>(results.size());
+
+            return true;
+        };
+
+        return baton.release();
     };
 
     const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        const auto baton = dynamic_cast<GetLibraryInfoBaton *>(b);
+        auto baton = dynamic_cast<DiscoverDevicesBaton *>(b);
         std::vector<v8::Local<v8::Value>> returnData;
 
-        returnData.emplace_back(LibraryInfo(baton->libraryInfo).ToJs());
+        // Devices that are still waiting for the async handle are delivered before the completion
+        baton->discovery->deliver();
+
+        returnData.emplace_back(Convert::toJsNumber(baton->deviceCount));
 
         return returnData;
     };
 
-    CallFunction(info, p, e, r, true);
+    CallFunction(info, p, nullptr, r, false);
 }
 
-NAN_METHOD(HighLevel::GetDeviceInfo)
+NAN_METHOD(HighLevel::InvalidateDeviceInfo)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new GetDeviceInfoBaton();
-    };
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<InvalidateDeviceInfoBaton>();
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<GetDeviceInfoBaton *>(b);
-        return NRFJPROG_get_device_info(b->probe, &baton->deviceInfo);
-    };
+        // The serial number is optional, without it all devices are invalidated
+        if (parameters.Length() > argumentCount + 1)
+        {
+            baton->invalidatedSerialNumber = Convert::getNativeUint32(parameters[argumentCount]);
+            ++argumentCount;
+        }
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        const auto baton = dynamic_cast<GetDeviceInfoBaton *>(b);
-        std::vector<v8::Local<v8::Value>> returnData;
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<InvalidateDeviceInfoBaton *>(b);
 
-        returnData.emplace_back(DeviceInfo(baton->deviceInfo).ToJs());
+            if (baton->invalidatedSerialNumber == 0)
+            {
+                pHighlvlStatic->deviceInfoCache.invalidateAll();
+            }
+            else
+            {
+                pHighlvlStatic->deviceInfoCache.invalidate(baton->invalidatedSerialNumber);
+            }
 
-        return returnData;
+            return true;
+        };
+
+        return baton.release();
     };
 
-    CallFunction(info, p, e, r, true);
+    CallFunction(info, p, nullptr, nullptr, false);
 }
 
-NAN_METHOD(HighLevel::Read)
+NAN_METHOD(HighLevel::StartProbeWatcher)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<ReadBaton>();
+        auto baton = std::make_unique<StartProbeWatcherBaton>();
 
-        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        const auto watcherOptions = Convert::getJsObject(parameters[argumentCount]);
+        const WatcherOptions options(watcherOptions);
+        ++argumentCount;
 
-        baton->length = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        const auto eventCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
+
+        baton->watcher = std::make_unique<ProbeWatcher>(options.options, eventCallback);
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<ReadBaton *>(b);
-        baton->data.resize(baton->length, 0);
-        return NRFJPROG_read(b->probe, baton->address, baton->data.data(), baton->length);
-    };
+        auto baton = dynamic_cast<StartProbeWatcherBaton *>(b);
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        auto baton = dynamic_cast<ReadBaton *>(b);
-        std::vector<v8::Local<v8::Value>> returnData;
+        if (pHighlvlStatic->probeWatcher)
+        {
+            return INVALID_OPERATION; // Already watching
+        }
 
-        returnData.emplace_back(Convert::toJsValueArray(baton->data.data(), baton->length));
+        const probe_list_function_t listProbes = [](std::vector<uint32_t> & serialNumbers) -> bool {
+            return listConnectedProbes(serialNumbers, INITIAL_SERIAL_NUMBERS) == SUCCESS;
+        };
 
-        return returnData;
+        baton->watcher->start(Baton::executionMutex, listProbes, &HighLevel::forgetProbe);
+        pHighlvlStatic->probeWatcher = std::move(baton->watcher);
+
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, r, true);
+    CallFunction(info, p, e, nullptr, false);
 }
 
-NAN_METHOD(HighLevel::ReadU32)
+NAN_METHOD(HighLevel::StopProbeWatcher)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton     = std::make_unique<ReadU32Baton>();
-        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
-
-        return baton.release();
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new StopProbeWatcherBaton();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<ReadU32Baton *>(b);
-        return NRFJPROG_read_u32(b->probe, baton->address, &baton->data);
+        auto baton = dynamic_cast<StopProbeWatcherBaton *>(b);
+
+        baton->watcher = std::move(pHighlvlStatic->probeWatcher);
+
+        if (baton->watcher)
+        {
+            baton->watcher->stop();
+        }
+
+        return SUCCESS;
     };
 
     const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        const auto baton = dynamic_cast<ReadU32Baton *>(b);
-        std::vector<v8::Local<v8::Value>> returnData;
+        auto baton = dynamic_cast<StopProbeWatcherBaton *>(b);
 
-        returnData.emplace_back(Convert::toJsNumber(baton->data));
+        // Events that are still waiting for the async handle are delivered before the completion
+        if (baton->watcher)
+        {
+            baton->watcher->deliver();
+        }
 
-        return returnData;
+        return {};
     };
 
-    CallFunction(info, p, e, r, true);
+    CallFunction(info, p, e, r, false);
 }
 
-NAN_METHOD(HighLevel::Program)
+NAN_METHOD(HighLevel::SetSimulatedProbes)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        std::unique_ptr<ProgramBaton> baton(new ProgramBaton());
-
-        baton->file = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+        auto baton = std::make_unique<SetSimulatedProbesBaton>();
 
-        const v8::Local<v8::Object> programOptions = Convert::getJsObject(parameters[argumentCount]);
-        const ProgramOptions options(programOptions);
-        baton->options     = options.options;
-        baton->inputFormat = options.inputFormat;
-        argumentCount++;
+        baton->serialNumbers = Convert::getVectorForUint32(parameters[argumentCount]);
+        ++argumentCount;
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<ProgramBaton *>(b);
-
-        FileFormatHandler file(baton->file, baton->inputFormat);
+        auto baton = dynamic_cast<SetSimulatedProbesBaton *>(b);
 
-        if (!file.exists())
+        if (!pHighlvlStatic->probeWatcher || !pHighlvlStatic->probeWatcher->isSimulated())
         {
-            log(file.errormessage() + "\n");
-            return INVALID_PARAMETER;
+            return INVALID_OPERATION;
         }
 
-        baton->filename = file.getFileName();
-
-        auto programResult = NRFJPROG_program(b->probe, baton->filename.c_str(), baton->options);
-
-        if (programResult == NOT_AVAILABLE_BECAUSE_PROTECTION && baton->options.chip_erase_mode == ERASE_ALL)
-        {
-            const nrfjprogdll_err_t recoverResult = NRFJPROG_recover(b->probe);
-
-            if (recoverResult == SUCCESS)
-            {
-                programResult = NRFJPROG_program(b->probe, baton->filename.c_str(), baton->options);
-            }
-            else
-            {
-                programResult = recoverResult;
-            }
-        }
+        pHighlvlStatic->probeWatcher->setSimulatedProbes(baton->serialNumbers);
 
-        return programResult;
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    CallFunction(info, p, e, nullptr, false);
 }
 
-NAN_METHOD(HighLevel::ProgramDFU)
+NAN_METHOD(HighLevel::StartHealthMonitor)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton      = std::make_unique<ProgramDFUBaton>();
-        baton->filename = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+        auto baton = std::make_unique<StartHealthMonitorBaton>();
+
+        const auto monitorOptions = Convert::getJsObject(parameters[argumentCount]);
+        const HealthMonitorOptions options(monitorOptions);
+        ++argumentCount;
+
+        const auto eventCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
+
+        baton->monitor = std::make_unique<ProbeHealthMonitor>(options.options, eventCallback);
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<ProgramDFUBaton *>(b);
-
-        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+        auto baton = dynamic_cast<StartHealthMonitorBaton *>(b);
+        std::unique_lock<std::mutex> lock(pHighlvlStatic->healthMonitorMutex);
 
-        if (!file.exists())
+        if (pHighlvlStatic->healthMonitor)
         {
-            log(file.errormessage() + "\n");
-            return INVALID_PARAMETER;
+            return INVALID_OPERATION; // Already monitoring
         }
 
-        const std::string filename = file.getFileName();
-        program_options_t options;
-        options.verify          = VERIFY_HASH;
-        options.chip_erase_mode = ERASE_NONE;
-        options.qspi_erase_mode = ERASE_NONE;
-        options.reset           = RESET_NONE;
+        const probe_list_open_function_t listOpenProbes = []() { return pHighlvlStatic->getOpenSerialNumbers(); };
+
+        baton->monitor->start(listOpenProbes, &HighLevel::checkProbeHealth);
+        pHighlvlStatic->healthMonitor = std::move(baton->monitor);
 
-        return NRFJPROG_program(b->probe, filename.c_str(), options);
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    CallFunction(info, p, e, nullptr, false);
 }
 
-NAN_METHOD(HighLevel::ProgramMcuBootDFU)
+NAN_METHOD(HighLevel::StopHealthMonitor)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<ProgramMcuBootDFUBaton>();
-
-        baton->filename = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new StopHealthMonitorBaton();
+    };
 
-        baton->uart = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<StopHealthMonitorBaton *>(b);
 
-        baton->baudRate = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        {
+            std::unique_lock<std::mutex> lock(pHighlvlStatic->healthMonitorMutex);
+            baton->monitor = std::move(pHighlvlStatic->healthMonitor);
+        }
 
-        baton->responseTimeout = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        if (baton->monitor)
+        {
+            baton->monitor->stop();
+        }
 
-        return baton.release();
+        return SUCCESS;
     };
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<ProgramMcuBootDFUBaton *>(b);
-        nrfjprogdll_err_t programResult;
-
-        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<StopHealthMonitorBaton *>(b);
 
-        if (!file.exists())
+        // Events that are still waiting for the async handle are delivered before the completion
+        if (baton->monitor)
         {
-            log(file.errormessage() + "\n");
-            return INVALID_PARAMETER;
+            baton->monitor->deliver();
         }
 
-        const std::string filename = file.getFileName();
-        program_options_t options;
-        options.verify          = VERIFY_NONE;
-        options.chip_erase_mode = ERASE_NONE;
-        options.qspi_erase_mode = ERASE_NONE;
-        options.reset           = RESET_SYSTEM;
-
-        programResult = NRFJPROG_program(b->probe, filename.c_str(), options);
-        return programResult;
+        return {};
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    CallFunction(info, p, e, r, false);
 }
 
-NAN_METHOD(HighLevel::ProgramModemUartDFU)
+NAN_METHOD(HighLevel::GetProbeHealth)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<ProgramModemUartDFUBaton>();
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetProbeHealthBaton>();
 
-        baton->filename = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+        // The snapshot is kept up to date by the monitor, there is no need to wait for other functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetProbeHealthBaton *>(b);
+            std::unique_lock<std::mutex> lock(pHighlvlStatic->healthMonitorMutex);
 
-        baton->uart = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+            if (!pHighlvlStatic->healthMonitor)
+            {
+                baton->result        = errorcode_t::CouldNotCallFunction;
+                baton->lowlevelError = INVALID_OPERATION;
+                return true;
+            }
+
+            baton->health = pHighlvlStatic->healthMonitor->getSnapshot();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetProbeHealthBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> health = Nan::New<v8::Array>();
+        int i                       = 0;
+        for (const auto & probeHealth : baton->health)
+        {
+            Nan::Set(health, Convert::toJsNumber(i), ProbeHealthInfo(probeHealth).ToJs());
+            ++i;
+        }
+
+        returnData.emplace_back(health);
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::GetStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetStatsBaton>();
+
+        // Statistics are recorded on the JS thread, there is no need to wait for other functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton           = dynamic_cast<GetStatsBaton *>(b);
+            baton->methods       = pHighlvlStatic->operationStatistics.getMethods();
+            baton->serialNumbers = pHighlvlStatic->operationStatistics.getSerialNumbers();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetStatsBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(OperationStatisticsInfo(baton->methods, baton->serialNumbers).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::SetTimingEnabled)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<SetTimingEnabledBaton>();
+
+        baton->enabled = Convert::getBool(parameters[argumentCount]);
+        ++argumentCount;
+
+        // Only read when a callback is called, so this applies from the next callback on
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton                    = dynamic_cast<SetTimingEnabledBaton *>(b);
+            pHighlvlStatic->timingEnabled = baton->enabled;
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::ResetStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<ResetStatsBaton>();
+
+        baton->unlockedFunction = [](Baton *) -> bool {
+            pHighlvlStatic->operationStatistics.reset();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::GetLibraryCallStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetLibraryCallStatsBaton>();
+
+        // Calls are counted by the threads making them, there is no need to wait for other functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton           = dynamic_cast<GetLibraryCallStatsBaton *>(b);
+            baton->functions     = LibraryCallStatistics::getFunctions();
+            baton->serialNumbers = LibraryCallStatistics::getSerialNumbers();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetLibraryCallStatsBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(LibraryCallStatisticsInfo(baton->functions, baton->serialNumbers).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::ResetLibraryCallStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<ResetLibraryCallStatsBaton>();
+
+        baton->unlockedFunction = [](Baton *) -> bool {
+            LibraryCallStatistics::reset();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::GetThroughputStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetThroughputStatsBaton>();
+
+        // Transfers are counted by the threads making them, there is no need to wait for other functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton           = dynamic_cast<GetThroughputStatsBaton *>(b);
+            baton->serialNumbers = ThroughputCounters::get();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetThroughputStatsBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(ThroughputInfo(baton->serialNumbers).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::ResetThroughputStats)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<ResetThroughputStatsBaton>();
+
+        baton->unlockedFunction = [](Baton *) -> bool {
+            ThroughputCounters::reset();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::SetLogLevel)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<SetLogLevelBaton>();
+
+        const auto level = Convert::getNativeUint32(parameters[argumentCount]);
+
+        if (level > LOG_LEVEL_NONE)
+        {
+            throw std::runtime_error("Not a log level");
+        }
+
+        baton->level = static_cast<log_level_t>(level);
+        ++argumentCount;
+
+        // Records are filtered when they are added, so this also applies to running functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<SetLogLevelBaton *>(b);
+            LogRing::setLevel(baton->level);
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::GetLog)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<GetLogBaton>();
+
+        if (parameters.Length() > argumentCount + 1)
+        {
+            const auto logOptions = Convert::getJsObject(parameters[argumentCount]);
+            baton->options        = LogOptions(logOptions);
+            ++argumentCount;
+        }
+
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetLogBaton *>(b);
+
+            for (auto & record : LogRing::copy(baton->options.since))
+            {
+                if (baton->options.matches(record))
+                {
+                    baton->records.push_back(std::move(record));
+                }
+            }
+
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetLogBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> records = Nan::New<v8::Array>();
+        int i                        = 0;
+        for (const auto & record : baton->records)
+        {
+            Nan::Set(records, Convert::toJsNumber(i), LogRecordInfo(record).ToJs());
+            i++;
+        }
+
+        returnData.emplace_back(records);
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::SubscribeLog)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<SubscribeLogBaton>();
+
+        const auto subscriptionOptions = Convert::getJsObject(parameters[argumentCount]);
+        const LogSubscriptionOptions options(subscriptionOptions);
+        ++argumentCount;
+
+        const auto recordsCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
+
+        baton->subscriber = std::make_unique<LogSubscriber>(options.options, recordsCallback);
+
+        // Logs are most interesting while other functions are running, so this does not wait for them
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<SubscribeLogBaton *>(b);
+            std::unique_lock<std::mutex> lock(pHighlvlStatic->logSubscriberMutex);
+
+            if (pHighlvlStatic->logSubscriber)
+            {
+                baton->result        = errorcode_t::CouldNotCallFunction;
+                baton->lowlevelError = INVALID_OPERATION; // Already subscribed
+                return true;
+            }
+
+            baton->subscriber->start();
+            pHighlvlStatic->logSubscriber = std::move(baton->subscriber);
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::UnsubscribeLog)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<UnsubscribeLogBaton>();
+
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<UnsubscribeLogBaton *>(b);
+
+            {
+                std::unique_lock<std::mutex> lock(pHighlvlStatic->logSubscriberMutex);
+                baton->subscriber = std::move(pHighlvlStatic->logSubscriber);
+            }
+
+            if (baton->subscriber)
+            {
+                baton->subscriber->stop();
+            }
+
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<UnsubscribeLogBaton *>(b);
+
+        // Records that are still waiting for the async handle are delivered before the completion
+        if (baton->subscriber)
+        {
+            baton->subscriber->deliver();
+        }
+
+        return {};
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::StartTrace)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<StartTraceBaton>();
+
+        if (parameters.Length() > argumentCount + 1)
+        {
+            const auto traceOptions = Convert::getJsObject(parameters[argumentCount]);
+            baton->options          = TraceOptions(traceOptions);
+            ++argumentCount;
+        }
+
+        // Tracing does not wait for the functions that are already running
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<StartTraceBaton *>(b);
+            OperationTrace::start(baton->options.capacity);
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::StopTrace)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<StopTraceBaton>();
+
+        // The events are kept until they are flushed
+        baton->unlockedFunction = [](Baton *) -> bool {
+            OperationTrace::stop();
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    CallFunction(info, p, nullptr, nullptr, false);
+}
+
+NAN_METHOD(HighLevel::FlushTrace)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<FlushTraceBaton>();
+
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        ++argumentCount;
+
+        // The file is written on the thread pool, without waiting for other functions
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<FlushTraceBaton *>(b);
+
+            if (!OperationTrace::flush(baton->filename, baton->eventCount))
+            {
+                baton->result = errorcode_t::CouldNotCallFunction;
+            }
+
+            return true;
+        };
+
+        return baton.release();
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<FlushTraceBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(Convert::toJsNumber(static_cast<double>(baton->eventCount)));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, nullptr, r, false);
+}
+
+NAN_METHOD(HighLevel::GetSerialNumbers)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<GetSerialNumbersBaton>();
+
+        // The options are optional, without them all serial numbers are returned
+        if (parameters.Length() > argumentCount + 1)
+        {
+            const auto enumerationOptions = Convert::getJsObject(parameters[argumentCount]);
+            baton->options                = EnumerationOptions(enumerationOptions);
+            ++argumentCount;
+        }
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<GetSerialNumbersBaton *>(b);
+        std::vector<uint32_t> serialNumbers;
+        const auto error = listConnectedProbes(serialNumbers, INITIAL_SERIAL_NUMBERS);
+
+        if (error != SUCCESS)
+        {
+            return error;
+        }
+
+        baton->serialNumbers = baton->options.apply(serialNumbers);
+
+        return SUCCESS;
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<GetSerialNumbersBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> serialNumbers = Nan::New<v8::Array>();
+        int i                              = 0;
+        for (auto serialNumber : baton->serialNumbers)
+        {
+            Nan::Set(serialNumbers, Convert::toJsNumber(i), Convert::toJsNumber(serialNumber));
+            ++i;
+        }
+
+        returnData.emplace_back(serialNumbers);
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, false);
+}
+
+NAN_METHOD(HighLevel::GetProbeInfo)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetProbeInfoBaton>();
+
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetProbeInfoBaton *>(b);
+            return pHighlvlStatic->deviceInfoCache.getProbeInfo(b->serialNumber, baton->probeInfo);
+        };
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<GetProbeInfoBaton *>(b);
+
+        const auto status = DLL_CALL(NRFJPROG_get_probe_info, b->probe, &baton->probeInfo);
+
+        if (status == SUCCESS)
+        {
+            pHighlvlStatic->deviceInfoCache.storeProbeInfo(b->serialNumber, baton->probeInfo);
+        }
+
+        return status;
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        const auto baton = dynamic_cast<GetProbeInfoBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(ProbeInfo(baton->probeInfo).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::GetLibraryInfo)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetLibraryInfoBaton>();
+
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetLibraryInfoBaton *>(b);
+            return pHighlvlStatic->deviceInfoCache.getLibraryInfo(b->serialNumber, baton->libraryInfo);
+        };
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<GetLibraryInfoBaton *>(b);
+
+        const auto status = DLL_CALL(NRFJPROG_get_library_info, b->probe, &baton->libraryInfo);
+
+        if (status == SUCCESS)
+        {
+            pHighlvlStatic->deviceInfoCache.storeLibraryInfo(b->serialNumber, baton->libraryInfo);
+        }
+
+        return status;
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        const auto baton = dynamic_cast<GetLibraryInfoBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(LibraryInfo(baton->libraryInfo).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::GetDeviceInfo)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<GetDeviceInfoBaton>();
+
+        baton->unlockedFunction = [](Baton * b) -> bool {
+            auto baton = dynamic_cast<GetDeviceInfoBaton *>(b);
+            return pHighlvlStatic->deviceInfoCache.getDeviceInfo(b->serialNumber, b->coProcessor, baton->deviceInfo);
+        };
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<GetDeviceInfoBaton *>(b);
+
+        const auto status = DLL_CALL(NRFJPROG_get_device_info, b->probe, &baton->deviceInfo);
+
+        if (status == SUCCESS)
+        {
+            pHighlvlStatic->deviceInfoCache.storeDeviceInfo(b->serialNumber, b->coProcessor, baton->deviceInfo);
+        }
+
+        return status;
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        const auto baton = dynamic_cast<GetDeviceInfoBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(DeviceInfo(baton->deviceInfo).ToJs());
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::Read)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<ReadBaton>();
+
+        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->length = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<ReadBaton *>(b);
+        baton->data.resize(baton->length, 0);
+        return DLL_TRANSFER(THROUGHPUT_READ,
+                            baton->length,
+                            NRFJPROG_read,
+                            b->probe,
+                            baton->address,
+                            baton->data.data(),
+                            baton->length);
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<ReadBaton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(Convert::toJsValueArray(baton->data.data(), baton->length));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::ReadU32)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton     = std::make_unique<ReadU32Baton>();
+        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<ReadU32Baton *>(b);
+        return DLL_TRANSFER(
+            THROUGHPUT_READ, sizeof(baton->data), NRFJPROG_read_u32, b->probe, baton->address, &baton->data);
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        const auto baton = dynamic_cast<ReadU32Baton *>(b);
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(Convert::toJsNumber(baton->data));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::Program)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        std::unique_ptr<ProgramBaton> baton(new ProgramBaton());
+
+        baton->file = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        const v8::Local<v8::Object> programOptions = Convert::getJsObject(parameters[argumentCount]);
+        const ProgramOptions options(programOptions);
+        baton->options     = options.options;
+        baton->inputFormat = options.inputFormat;
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<ProgramBaton *>(b);
+
+        // The device may be recovered, and the firmware may change what the device reports
+        pHighlvlStatic->deviceInfoCache.invalidate(b->serialNumber);
+
+        FileFormatHandler file(baton->file, baton->inputFormat);
+
+        if (!file.exists())
+        {
+            log(file.errormessage() + "\n");
+            return INVALID_PARAMETER;
+        }
+
+        baton->filename     = file.getFileName();
+        const auto dataSize = hexFileDataSize(baton->filename);
+
+        auto programResult = DLL_TRANSFER(
+            THROUGHPUT_PROGRAM, dataSize, NRFJPROG_program, b->probe, baton->filename.c_str(), baton->options);
+
+        if (programResult == NOT_AVAILABLE_BECAUSE_PROTECTION && baton->options.chip_erase_mode == ERASE_ALL)
+        {
+            const nrfjprogdll_err_t recoverResult = DLL_CALL(NRFJPROG_recover, b->probe);
+
+            if (recoverResult == SUCCESS)
+            {
+                programResult = DLL_TRANSFER(
+                    THROUGHPUT_PROGRAM, dataSize, NRFJPROG_program, b->probe, baton->filename.c_str(), baton->options);
+            }
+            else
+            {
+                programResult = recoverResult;
+            }
+        }
+
+        return programResult;
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::ProgramDFU)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton      = std::make_unique<ProgramDFUBaton>();
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<ProgramDFUBaton *>(b);
+
+        pHighlvlStatic->deviceInfoCache.invalidate(b->serialNumber);
+
+        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+
+        if (!file.exists())
+        {
+            log(file.errormessage() + "\n");
+            return INVALID_PARAMETER;
+        }
+
+        const std::string filename = file.getFileName();
+        program_options_t options;
+        options.verify          = VERIFY_HASH;
+        options.chip_erase_mode = ERASE_NONE;
+        options.qspi_erase_mode = ERASE_NONE;
+        options.reset           = RESET_NONE;
+
+        return DLL_CALL(NRFJPROG_program, b->probe, filename.c_str(), options);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::ProgramMcuBootDFU)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<ProgramMcuBootDFUBaton>();
+
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->uart = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->baudRate = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->responseTimeout = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<ProgramMcuBootDFUBaton *>(b);
+        nrfjprogdll_err_t programResult;
+
+        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+
+        if (!file.exists())
+        {
+            log(file.errormessage() + "\n");
+            return INVALID_PARAMETER;
+        }
+
+        const std::string filename = file.getFileName();
+        program_options_t options;
+        options.verify          = VERIFY_NONE;
+        options.chip_erase_mode = ERASE_NONE;
+        options.qspi_erase_mode = ERASE_NONE;
+        options.reset           = RESET_SYSTEM;
+
+        programResult = DLL_CALL(NRFJPROG_program, b->probe, filename.c_str(), options);
+        return programResult;
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::ProgramModemUartDFU)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<ProgramModemUartDFUBaton>();
+
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->uart = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->baudRate = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->responseTimeout = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<ProgramModemUartDFUBaton *>(b);
+        nrfjprogdll_err_t programResult;
+
+        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+
+        if (!file.exists())
+        {
+            log(file.errormessage() + "\n");
+            return INVALID_PARAMETER;
+        }
+
+        const std::string filename = file.getFileName();
+        program_options_t options;
+        options.verify          = VERIFY_NONE;
+        options.chip_erase_mode = ERASE_NONE;
+        options.qspi_erase_mode = ERASE_NONE;
+        options.reset           = RESET_SYSTEM;
+
+        programResult = DLL_CALL(NRFJPROG_program, b->probe, filename.c_str(), options);
+        return programResult;
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::ReadToFile)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<ReadToFileBaton>();
+
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        const v8::Local<v8::Object> readOptions = Convert::getJsObject(parameters[argumentCount]);
+        const ReadToFileOptions options(readOptions);
+        baton->options = options.options;
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<ReadToFileBaton *>(b);
+        // The size of what was read is only known from the file written
+        return DLL_TRANSFER(THROUGHPUT_READ,
+                            hexFileDataSize(baton->filename),
+                            NRFJPROG_read_to_file,
+                            b->probe,
+                            baton->filename.c_str(),
+                            baton->options);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::Verify)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<VerifyBaton>();
+
+        baton->filename = Convert::getNativeString(parameters[argumentCount]);
+        argumentCount++;
+
+        // There are no verify options at the moment, but there will be options
+        // (like the option that the incomming content may be a string)
+        Convert::getJsObject(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<VerifyBaton *>(b);
+        return DLL_TRANSFER(THROUGHPUT_VERIFY,
+                            hexFileDataSize(baton->filename),
+                            NRFJPROG_verify,
+                            b->probe,
+                            baton->filename.c_str(),
+                            VERIFY_READ);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::Erase)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton                               = std::make_unique<EraseBaton>();
+        const v8::Local<v8::Object> eraseOptions = Convert::getJsObject(parameters[argumentCount]);
+        const EraseOptions options(eraseOptions);
+        baton->erase_mode    = options.eraseMode;
+        baton->start_address = options.startAddress;
+        baton->end_address   = options.endAddress;
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<EraseBaton *>(b);
+        return DLL_CALL(NRFJPROG_erase, b->probe, baton->erase_mode, baton->start_address, baton->end_address);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::Recover)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new RecoverBaton();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        pHighlvlStatic->deviceInfoCache.invalidate(b->serialNumber);
+        return DLL_CALL(NRFJPROG_recover, b->probe);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::Reset)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new ResetBaton();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        return DLL_CALL(NRFJPROG_reset, b->probe, RESET_SYSTEM);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::Write)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<WriteBaton>();
+
+        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->data   = Convert::getVectorForUint8(parameters[argumentCount]);
+        baton->length = Convert::getLengthOfArray(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<WriteBaton *>(b);
+        return DLL_TRANSFER(THROUGHPUT_WRITE,
+                            baton->length,
+                            NRFJPROG_write,
+                            b->probe,
+                            baton->address,
+                            baton->data.data(),
+                            baton->length);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::WriteU32)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton     = std::make_unique<WriteU32Baton>();
+        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        baton->data = Convert::getNativeUint32(parameters[argumentCount]);
+        argumentCount++;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        const auto baton = dynamic_cast<WriteU32Baton *>(b);
+        return DLL_TRANSFER(
+            THROUGHPUT_WRITE, sizeof(baton->data), NRFJPROG_write_u32, b->probe, baton->address, baton->data);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::OpenDevice)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new OpenBaton();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        return pHighlvlStatic->registerProbe(b->serialNumber, b->probe);
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::CloseDevice)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new CloseBaton();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        pHighlvlStatic->unregisterProbe(b->serialNumber);
+        return SUCCESS;
+    };
+
+    CallFunction(info, p, e, nullptr, true);
+}
+
+NAN_METHOD(HighLevel::RttStart)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<RTTStartBaton>();
+
+        const auto startOptions = Convert::getJsObject(parameters[argumentCount]);
+        const StartOptions options(startOptions);
+        baton->hasControlBlockLocation = options.hasControlBlockLocation;
+        baton->controlBlockLocation    = options.controlBlockLocation;
+        baton->searchOptions           = options.searchOptions;
+        baton->bufferSize              = options.bufferSize;
+        baton->reset                   = options.reset;
+        baton->hasSearchRange          = options.hasSearchRange;
+        baton->searchRangeStart        = options.searchRangeStart;
+        baton->searchRangeLength       = options.searchRangeLength;
+        baton->elfPath                 = options.elfPath;
+        baton->autoRecover             = options.autoRecover;
+        ++argumentCount;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<RTTStartBaton *>(b);
+
+        // The baton is rescheduled for every poll until the control block is found
+        if (baton->searchStarted)
+        {
+            if (!b->session)
+            {
+                return INVALID_OPERATION; // Stopped while searching
+            }
+
+            return pollControlBlock(baton);
+        }
+
+        if (pHighlvlStatic->hasProbe(b->serialNumber))
+        {
+            return INVALID_OPERATION; // Already opened
+        }
+
+        // With the symbol from the firmware image, the DLL only has to read the control block
+        if (!baton->hasControlBlockLocation && !baton->elfPath.empty())
+        {
+            const auto result = findRttControlBlockInElf(
+                baton->elfPath, baton->hasControlBlockLocation, baton->controlBlockLocation);
+
+            if (result != SUCCESS)
+            {
+                log("Could not read the symbol table of " + baton->elfPath + "\n");
+                return result;
+            }
+        }
+
+        // Without the reset, RTT attaches to the running firmware and keeps its state
+        if (baton->reset)
+        {
+            const auto result = DLL_CALL(NRFJPROG_reset, b->probe, RESET_SYSTEM);
+            if (result != SUCCESS)
+            {
+                return result;
+            }
+        }
+
+        if (!baton->hasControlBlockLocation && baton->hasSearchRange)
+        {
+            // Searching a known range is much faster than the search of all RAM in the DLL,
+            // which is still used if the control block is not in the range
+            const auto result = findRttControlBlock(b->probe,
+                                                    baton->searchRangeStart,
+                                                    baton->searchRangeLength,
+                                                    baton->hasControlBlockLocation,
+                                                    baton->controlBlockLocation);
+
+            if (result != SUCCESS)
+            {
+                return result;
+            }
+        }
+
+        if (baton->hasControlBlockLocation)
+        {
+            const auto result =
+                DLL_CALL(NRFJPROG_rtt_set_control_block_address, b->probe, baton->controlBlockLocation);
+
+            if (result != SUCCESS)
+            {
+                rttCleanup(b->probe);
+                return result;
+            }
+        }
 
-        baton->baudRate = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        auto session = std::make_shared<RttSession>(b->serialNumber, b->probe);
 
-        baton->responseTimeout = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        const auto result = DLL_CALL(NRFJPROG_rtt_start, b->probe);
+
+        if (result != SUCCESS)
+        {
+            rttCleanup(b->probe);
+            return result;
+        }
+
+        // Add to registry to keep it open between the polls
+        const auto registerStatus = pHighlvlStatic->registerProbe(b->serialNumber, b->probe);
+
+        if (registerStatus != SUCCESS)
+        {
+            rttCleanup(b->probe);
+            return registerStatus;
+        }
+
+        // From here on, the polls and all other RTT functions on this probe run on the session lane
+        pHighlvlStatic->registerRttSession(session);
+        b->session = session;
+
+        baton->searchStarted   = true;
+        baton->searchStartTime = session->getStartTime();
+        baton->searchInterval  = baton->searchOptions.initialInterval;
+
+        return pollControlBlock(baton);
+    };
+
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<RTTStartBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> downChannelInfo = Nan::New<v8::Array>();
+        int i                                = 0;
+        for (auto & element : baton->downChannelInfo)
+        {
+            Nan::Set(downChannelInfo, Convert::toJsNumber(i), element->ToJs());
+            ++i;
+        }
+
+        returnData.emplace_back(downChannelInfo);
+
+        v8::Local<v8::Array> upChannelInfo = Nan::New<v8::Array>();
+        i                                  = 0;
+        for (auto & element : baton->upChannelInfo)
+        {
+            Nan::Set(upChannelInfo, Convert::toJsNumber(i), element->ToJs());
+            ++i;
+        }
+
+        returnData.emplace_back(upChannelInfo);
+        returnData.emplace_back(Convert::toTimeDifferenceUS(baton->searchStartTime, baton->searchEndTime));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
+}
+
+NAN_METHOD(HighLevel::RttStop)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton = std::make_unique<RTTStopBaton>();
+
+        // The session is going away, a recovery must not keep it on the lane until it times out
+        baton->unlockedFunction = &HighLevel::stopRttRecovery;
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<ProgramModemUartDFUBaton *>(b);
-        nrfjprogdll_err_t programResult;
+        return rttCleanup(b->probe);
+    };
 
-        FileFormatHandler file(baton->filename, INPUT_FORMAT_HEX_FILE);
+    CallFunction(info, p, e, nullptr, true);
+}
 
-        if (!file.exists())
+NAN_METHOD(HighLevel::RttRead)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<RTTReadBaton>();
+
+        baton->channelIndex = Convert::getNativeUint32(info[argumentCount]);
+        ++argumentCount;
+
+        baton->length = Convert::getNativeUint32(info[argumentCount]);
+        ++argumentCount;
+
+        return baton.release();
+    };
+
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<RTTReadBaton *>(b);
+
+        if (!b->session || !isRttStarted(b->probe))
         {
-            log(file.errormessage() + "\n");
-            return INVALID_PARAMETER;
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
         }
 
-        const std::string filename = file.getFileName();
-        program_options_t options;
-        options.verify          = VERIFY_NONE;
-        options.chip_erase_mode = ERASE_NONE;
-        options.qspi_erase_mode = ERASE_NONE;
-        options.reset           = RESET_SYSTEM;
+        baton->data.resize(baton->length, 0);
+        uint32_t readLength = 0;
 
-        programResult = NRFJPROG_program(b->probe, filename.c_str(), options);
-        return programResult;
+        baton->functionStart = std::chrono::high_resolution_clock::now();
+
+        auto status = SUCCESS;
+
+        // A buffering reader has already tried to recover when it reports an error
+        if (!b->session->readBuffered(baton->channelIndex, baton->data.data(), baton->length, readLength, status))
+        {
+            status = DLL_TRANSFER(THROUGHPUT_RTT_UP,
+                                  readLength,
+                                  NRFJPROG_rtt_read,
+                                  b->probe,
+                                  baton->channelIndex,
+                                  baton->data.data(),
+                                  baton->length,
+                                  &readLength);
+
+            if (status != SUCCESS)
+            {
+                readLength = 0;
+                status     = b->session->recover(status);
+            }
+        }
+
+        if (status != SUCCESS)
+        {
+            rttCleanup(b->probe);
+            return status;
+        }
+
+        baton->length = readLength;
+
+        return status;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<RTTReadBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(Convert::toJsString(baton->data.data(), baton->length));
+        returnData.emplace_back(
+            Convert::toJsValueArray(reinterpret_cast<uint8_t *>(baton->data.data()), baton->length));
+        returnData.emplace_back(Convert::toTimeDifferenceUS(b->session->getStartTime(), baton->functionStart));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
 }
 
-NAN_METHOD(HighLevel::ReadToFile)
+NAN_METHOD(HighLevel::RttReadMany)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<ReadToFileBaton>();
+        auto baton = std::make_unique<RTTReadManyBaton>();
 
-        baton->filename = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+        if (!parameters[argumentCount]->IsArray())
+        {
+            throw std::runtime_error("array");
+        }
 
-        const v8::Local<v8::Object> readOptions = Convert::getJsObject(parameters[argumentCount]);
-        const ReadToFileOptions options(readOptions);
-        baton->options = options.options;
-        argumentCount++;
+        const auto jsChannels = Convert::getJsObject(parameters[argumentCount]);
+        const auto count      = Convert::getLengthOfArray(parameters[argumentCount]);
+        uint64_t offset       = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto jsChannel = Convert::getJsObject(Utility::Get(jsChannels, static_cast<int>(i)));
+
+            RTTReadManyBaton::ChannelRead channel{};
+            channel.channelIndex = Convert::getNativeUint32(jsChannel, "channel");
+            channel.maxLength    = Convert::getNativeUint32(jsChannel, "maxLength");
+            channel.offset       = static_cast<uint32_t>(offset);
+
+            // All channels are read into one buffer, so its size is bounded by the sum of the lengths
+            offset += channel.maxLength;
+
+            if (offset > MAX_RTT_READ_MANY_LENGTH)
+            {
+                throw std::runtime_error("array with a total maxLength of at most 16777216 bytes");
+            }
+
+            baton->channels.push_back(channel);
+        }
+        ++argumentCount;
+
+        baton->data.resize(static_cast<size_t>(offset), 0);
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<ReadToFileBaton *>(b);
-        return NRFJPROG_read_to_file(b->probe, baton->filename.c_str(), baton->options);
+        auto baton = dynamic_cast<RTTReadManyBaton *>(b);
+
+        if (!b->session || !isRttStarted(b->probe))
+        {
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
+        }
+
+        baton->functionStart = std::chrono::high_resolution_clock::now();
+
+        // All channels share one buffer, so a channel without data only costs the read call
+        for (auto & channel : baton->channels)
+        {
+            auto status = SUCCESS;
+
+            if (!b->session->readBuffered(channel.channelIndex,
+                                          baton->data.data() + channel.offset,
+                                          channel.maxLength,
+                                          channel.length,
+                                          status))
+            {
+                status = DLL_TRANSFER(THROUGHPUT_RTT_UP,
+                                      channel.length,
+                                      NRFJPROG_rtt_read,
+                                      b->probe,
+                                      channel.channelIndex,
+                                      baton->data.data() + channel.offset,
+                                      channel.maxLength,
+                                      &channel.length);
+
+                if (status != SUCCESS)
+                {
+                    channel.length = 0;
+                    status         = b->session->recover(status);
+                }
+            }
+
+            if (status != SUCCESS)
+            {
+                rttCleanup(b->probe);
+                return status;
+            }
+        }
+
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<RTTReadManyBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> buffers = Nan::New<v8::Array>();
+        uint32_t i                   = 0;
+        for (const auto & channel : baton->channels)
+        {
+            Nan::Set(buffers, i, Convert::toJsBuffer(baton->data.data() + channel.offset, channel.length));
+            ++i;
+        }
+
+        returnData.emplace_back(buffers);
+        returnData.emplace_back(Convert::toTimeDifferenceUS(b->session->getStartTime(), baton->functionStart));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
 }
 
-NAN_METHOD(HighLevel::Verify)
+NAN_METHOD(HighLevel::RttWrite)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<VerifyBaton>();
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<RTTWriteBaton>();
 
-        baton->filename = Convert::getNativeString(parameters[argumentCount]);
-        argumentCount++;
+        baton->channelIndex = Convert::getNativeUint32(info[argumentCount]);
+        ++argumentCount;
 
-        // There are no verify options at the moment, but there will be options
-        // (like the option that the incomming content may be a string)
-        Convert::getJsObject(parameters[argumentCount]);
-        argumentCount++;
+        if (info[argumentCount]->IsString())
+        {
+            baton->data   = Convert::getVectorForChar(info[argumentCount]);
+            baton->length = static_cast<uint32_t>(Convert::getNativeString(info[argumentCount]).length());
+        }
+        else
+        {
+            const auto tempData = Convert::getVectorForUint8(info[argumentCount]);
+            baton->data         = std::vector<char>(tempData.begin(), tempData.end());
+            baton->length       = Convert::getLengthOfArray(info[argumentCount]);
+        }
+        ++argumentCount;
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<VerifyBaton *>(b);
-        return NRFJPROG_verify(b->probe, baton->filename.c_str(), VERIFY_READ);
+        auto baton = dynamic_cast<RTTWriteBaton *>(b);
+
+        if (!b->session || !isRttStarted(b->probe))
+        {
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
+        }
+
+        uint32_t writeLength = 0;
+
+        baton->functionStart = std::chrono::high_resolution_clock::now();
+
+        auto status = DLL_TRANSFER(THROUGHPUT_RTT_DOWN,
+                                   writeLength,
+                                   NRFJPROG_rtt_write,
+                                   b->probe,
+                                   baton->channelIndex,
+                                   baton->data.data(),
+                                   baton->length,
+                                   &writeLength);
+
+        // Nothing was written if RTT had to be re-armed, the caller writes again
+        if (status != SUCCESS)
+        {
+            writeLength = 0;
+            status      = b->session->recover(status);
+        }
+
+        if (status != SUCCESS)
+        {
+            rttCleanup(b->probe);
+            return status;
+        }
+
+        baton->length = writeLength;
+        return status;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        const auto baton = dynamic_cast<RTTWriteBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        returnData.emplace_back(Convert::toJsNumber(baton->length));
+        returnData.emplace_back(Convert::toTimeDifferenceUS(b->session->getStartTime(), baton->functionStart));
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
 }
 
-NAN_METHOD(HighLevel::Erase)
+NAN_METHOD(HighLevel::RttSubscribe)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton                               = std::make_unique<EraseBaton>();
-        const v8::Local<v8::Object> eraseOptions = Convert::getJsObject(parameters[argumentCount]);
-        const EraseOptions options(eraseOptions);
-        baton->erase_mode    = options.eraseMode;
-        baton->start_address = options.startAddress;
-        baton->end_address   = options.endAddress;
-        argumentCount++;
+        auto baton = std::make_unique<RTTSubscribeBaton>();
+
+        const auto channels = Convert::getVectorForUint32(parameters[argumentCount]);
+        baton->channelCount = channels.size();
+        ++argumentCount;
+
+        const auto subscribeOptions = Convert::getJsObject(parameters[argumentCount]);
+        const SubscribeOptions options(subscribeOptions);
+        ++argumentCount;
+
+        const auto dataCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
+
+        baton->reader = std::make_unique<RttReader>(channels, options.options, dataCallback);
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<EraseBaton *>(b);
-        return NRFJPROG_erase(b->probe, baton->erase_mode, baton->start_address, baton->end_address);
-    };
-
-    CallFunction(info, p, e, nullptr, true);
-}
+        auto baton = dynamic_cast<RTTSubscribeBaton *>(b);
 
-NAN_METHOD(HighLevel::Recover)
-{
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new RecoverBaton();
-    };
+        // The reader keeps using the probe after this call, so it must be held open by rttStart
+        if (!b->session || !isRttStarted(b->probe))
+        {
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
+        }
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        return NRFJPROG_recover(b->probe);
+        return b->session->startReader(baton->reader);
     };
 
     CallFunction(info, p, e, nullptr, true);
 }
 
-NAN_METHOD(HighLevel::Reset)
+NAN_METHOD(HighLevel::RttUnsubscribe)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new ResetBaton();
+        auto baton              = std::make_unique<RTTUnsubscribeBaton>();
+        baton->unlockedFunction = &HighLevel::interruptRttRecovery;
+
+        return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        return NRFJPROG_reset(b->probe, RESET_SYSTEM);
+        if (!b->session)
+        {
+            return SUCCESS;
+        }
+
+        return b->session->releaseReader(RTT_READER_SUBSCRIPTION);
     };
 
     CallFunction(info, p, e, nullptr, true);
 }
 
-NAN_METHOD(HighLevel::Write)
+NAN_METHOD(HighLevel::RttCapture)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<WriteBaton>();
-
-        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        auto baton = std::make_unique<RTTCaptureBaton>();
 
-        baton->data   = Convert::getVectorForUint8(parameters[argumentCount]);
-        baton->length = Convert::getLengthOfArray(parameters[argumentCount]);
-        argumentCount++;
-
-        return baton.release();
-    };
+        baton->channelIndex = Convert::getNativeUint32(parameters[argumentCount]);
+        ++argumentCount;
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<WriteBaton *>(b);
-        return NRFJPROG_write(b->probe, baton->address, baton->data.data(), baton->length);
-    };
+        baton->path = Convert::getNativeString(parameters[argumentCount]);
+        ++argumentCount;
 
-    CallFunction(info, p, e, nullptr, true);
-}
+        const auto captureOptions = Convert::getJsObject(parameters[argumentCount]);
+        const CaptureOptions options(captureOptions);
+        ++argumentCount;
 
-NAN_METHOD(HighLevel::WriteU32)
-{
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton     = std::make_unique<WriteU32Baton>();
-        baton->address = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        const auto statisticsCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
 
-        baton->data = Convert::getNativeUint32(parameters[argumentCount]);
-        argumentCount++;
+        baton->reader = std::make_unique<RttReader>(baton->channelIndex,
+                                                    options.readerOptions,
+                                                    std::make_unique<RttCaptureFile>(baton->path, options.options),
+                                                    statisticsCallback);
 
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        const auto baton = dynamic_cast<WriteU32Baton *>(b);
-        return NRFJPROG_write_u32(b->probe, baton->address, baton->data);
-    };
+        auto baton = dynamic_cast<RTTCaptureBaton *>(b);
 
-    CallFunction(info, p, e, nullptr, true);
-}
+        // The reader keeps using the probe after this call, so it must be held open by rttStart
+        if (!b->session || !isRttStarted(b->probe))
+        {
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
+        }
 
-NAN_METHOD(HighLevel::OpenDevice)
-{
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new OpenBaton();
-    };
+        if (!baton->reader->openCapture())
+        {
+            log("Could not open the capture file " + baton->path + "\n");
+            return INVALID_PARAMETER;
+        }
 
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        return pHighlvlStatic->registerProbe(b->serialNumber, b->probe);
+        return b->session->startReader(baton->reader);
     };
 
     CallFunction(info, p, e, nullptr, true);
 }
 
-NAN_METHOD(HighLevel::CloseDevice)
+NAN_METHOD(HighLevel::RttStopCapture)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new CloseBaton();
+        auto baton              = std::make_unique<RTTStopCaptureBaton>();
+        baton->unlockedFunction = &HighLevel::interruptRttRecovery;
+
+        return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        pHighlvlStatic->unregisterProbe(b->serialNumber);
-        return SUCCESS;
+        if (!b->session)
+        {
+            return SUCCESS;
+        }
+
+        return b->session->releaseReader(RTT_READER_CAPTURE);
     };
 
     CallFunction(info, p, e, nullptr, true);
 }
 
-NAN_METHOD(HighLevel::RttStart)
+NAN_METHOD(HighLevel::RttOpenSharedRing)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<RTTStartBaton>();
+        auto baton = std::make_unique<RTTOpenSharedRingBaton>();
 
-        const auto startOptions = Convert::getJsObject(parameters[argumentCount]);
-        const StartOptions options(startOptions);
-        baton->hasControlBlockLocation = options.hasControlBlockLocation;
-        baton->controlBlockLocation    = options.controlBlockLocation;
+        baton->channelIndex = Convert::getNativeUint32(parameters[argumentCount]);
         ++argumentCount;
 
-        return baton.release();
-    };
-
-    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<RTTStartBaton *>(b);
-
-        if (pHighlvlStatic->hasProbe(baton->serialNumber))
+        if (!parameters[argumentCount]->IsSharedArrayBuffer())
         {
-            return INVALID_OPERATION; // Already opened
+            throw std::runtime_error("sharedarraybuffer");
         }
 
+        const auto buffer = parameters[argumentCount].As<v8::SharedArrayBuffer>();
+        baton->length     = buffer->ByteLength();
+
+        // The indexes wrap at 2^32, so the ring must be smaller than that to tell full from empty
+        const auto headerLength = RTT_SHARED_RING_HEADER_WORDS * sizeof(uint32_t);
+
+        if (baton->length <= headerLength || baton->length - headerLength > 0x80000000U)
         {
-            const auto result = NRFJPROG_reset(b->probe, RESET_SYSTEM);
-            if (result != SUCCESS)
-            {
-                return result;
-            }
+            throw std::runtime_error("sharedarraybuffer length");
         }
+        ++argumentCount;
 
-        if (baton->hasControlBlockLocation)
-        {
-            const auto result = NRFJPROG_rtt_set_control_block_address(b->probe, baton->controlBlockLocation);
+        const auto subscribeOptions = Convert::getJsObject(parameters[argumentCount]);
+        const SubscribeOptions options(subscribeOptions);
+        ++argumentCount;
 
-            if (result != SUCCESS)
-            {
-                rttCleanup(b->probe);
-                return result;
-            }
-        }
+        const auto errorCallback = Convert::getCallbackFunction(parameters[argumentCount]);
+        ++argumentCount;
 
-        pHighlvlStatic->rttStartTime = std::chrono::high_resolution_clock::now();
+        baton->reader = std::make_unique<RttReader>(
+            baton->channelIndex, options.options, std::make_unique<RttSharedRing>(buffer), errorCallback);
 
-        const auto result = NRFJPROG_rtt_start(b->probe);
+        return baton.release();
+    };
 
-        if (result != SUCCESS)
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<RTTOpenSharedRingBaton *>(b);
+
+        // The reader keeps using the probe after this call, so it must be held open by rttStart
+        if (!b->session || !isRttStarted(b->probe))
         {
-            rttCleanup(b->probe);
-            return result;
+            baton->rttNotStarted = true;
+            return INTERNAL_ERROR;
         }
 
-        const auto waitStatus = waitForControlBlock(baton->probe, baton->foundControlBlock);
+        return b->session->startReader(baton->reader);
+    };
 
-        if (waitStatus != SUCCESS)
-        {
-            rttCleanup(b->probe);
-            return waitStatus;
-        }
+    CallFunction(info, p, e, nullptr, true);
+}
 
-        const auto channelInfo = getChannelInformation(baton, baton->foundChannelInformation);
+NAN_METHOD(HighLevel::RttCloseSharedRing)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton              = std::make_unique<RTTCloseSharedRingBaton>();
+        baton->unlockedFunction = &HighLevel::interruptRttRecovery;
+
+        return baton.release();
+    };
 
-        if (channelInfo != SUCCESS)
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        if (!b->session)
         {
-            return channelInfo;
+            return SUCCESS;
         }
 
-        // Add to registry to keep it open
-        return pHighlvlStatic->registerProbe(b->serialNumber, b->probe);
+        return b->session->releaseReader(RTT_READER_SHARED_RING);
     };
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        auto baton = dynamic_cast<RTTStartBaton *>(b);
+    CallFunction(info, p, e, nullptr, true);
+}
 
-        std::vector<v8::Local<v8::Value>> returnData;
+NAN_METHOD(HighLevel::RttGetBufferStatistics)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        return new RTTGetBufferStatisticsBaton();
+    };
 
-        v8::Local<v8::Array> downChannelInfo = Nan::New<v8::Array>();
-        int i                                = 0;
-        for (auto & element : baton->downChannelInfo)
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        auto baton = dynamic_cast<RTTGetBufferStatisticsBaton *>(b);
+
+        if (!b->session || !b->session->getBufferStatistics(baton->statistics))
         {
-            Nan::Set(downChannelInfo, Convert::toJsNumber(i), element->ToJs());
-            ++i;
+            baton->rttNotBuffered = true;
+            return INVALID_OPERATION;
         }
 
-        returnData.emplace_back(downChannelInfo);
+        return SUCCESS;
+    };
 
-        v8::Local<v8::Array> upChannelInfo = Nan::New<v8::Array>();
-        i                                  = 0;
-        for (auto & element : baton->upChannelInfo)
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<RTTGetBufferStatisticsBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Array> statistics = Nan::New<v8::Array>();
+        uint32_t i                      = 0;
+        for (const auto & channel : baton->statistics)
         {
-            Nan::Set(upChannelInfo, Convert::toJsNumber(i), element->ToJs());
+            v8::Local<v8::Object> channelObj = Nan::New<v8::Object>();
+            Utility::Set(channelObj, "channelIndex", Convert::toJsNumber(channel.first));
+            Utility::Set(channelObj, "capacity", Convert::toJsNumber(channel.second.capacity));
+            Utility::Set(channelObj, "used", Convert::toJsNumber(channel.second.used));
+            Utility::Set(channelObj, "highWaterMark", Convert::toJsNumber(channel.second.highWaterMark));
+            Utility::Set(
+                channelObj, "bytesReceived", Convert::toJsNumber(static_cast<double>(channel.second.bytesReceived)));
+            Utility::Set(
+                channelObj, "bytesDropped", Convert::toJsNumber(static_cast<double>(channel.second.bytesDropped)));
+            Utility::Set(
+                channelObj, "bytesRead", Convert::toJsNumber(static_cast<double>(channel.second.bytesRead)));
+            Utility::Set(channelObj,
+                         "readLatency",
+                         Convert::toJsNumber(static_cast<double>(channel.second.lastReadLatency.count())));
+            Utility::Set(channelObj,
+                         "maxReadLatency",
+                         Convert::toJsNumber(static_cast<double>(channel.second.maxReadLatency.count())));
+
+            Nan::Set(statistics, i, channelObj);
             ++i;
         }
 
-        returnData.emplace_back(upChannelInfo);
+        returnData.emplace_back(statistics);
 
         return returnData;
     };
@@ -1483,95 +3382,130 @@ NAN_METHOD(HighLevel::RttStart)
     CallFunction(info, p, e, r, true);
 }
 
-NAN_METHOD(HighLevel::RttStop)
+NAN_METHOD(HighLevel::RttGetSessionStatistics)
 {
     const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
-        return new RTTStopBaton();
+        return new RTTGetSessionStatisticsBaton();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        return rttCleanup(b->probe);
+        auto baton = dynamic_cast<RTTGetSessionStatisticsBaton *>(b);
+
+        if (!b->session)
+        {
+            return INVALID_OPERATION;
+        }
+
+        baton->recovery         = b->session->getRecoveryStatistics();
+        baton->upChannelCount   = b->session->getUpChannelCount();
+        baton->downChannelCount = b->session->getDownChannelCount();
+
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, nullptr, true);
+    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
+        auto baton = dynamic_cast<RTTGetSessionStatisticsBaton *>(b);
+
+        std::vector<v8::Local<v8::Value>> returnData;
+
+        v8::Local<v8::Object> statistics = Nan::New<v8::Object>();
+        Utility::Set(statistics, "autoRecover", Convert::toJsBool(baton->recovery.enabled));
+
+        if (baton->recovery.hasControlBlockAddress)
+        {
+            Utility::Set(statistics, "controlBlockLocation", Convert::toJsNumber(baton->recovery.controlBlockAddress));
+        }
+
+        Utility::Set(statistics, "upChannelCount", Convert::toJsNumber(static_cast<uint32_t>(baton->upChannelCount)));
+        Utility::Set(
+            statistics, "downChannelCount", Convert::toJsNumber(static_cast<uint32_t>(baton->downChannelCount)));
+        Utility::Set(statistics, "reconnects", Convert::toJsNumber(baton->recovery.reconnects));
+        Utility::Set(statistics, "failedRecoveries", Convert::toJsNumber(baton->recovery.failedRecoveries));
+        Utility::Set(
+            statistics, "downtime", Convert::toJsNumber(static_cast<double>(baton->recovery.downtime.count())));
+        Utility::Set(statistics,
+                     "lastDowntime",
+                     Convert::toJsNumber(static_cast<double>(baton->recovery.lastDowntime.count())));
+        Utility::Set(statistics, "lastError", Convert::toJsNumber(static_cast<int32_t>(baton->recovery.lastError)));
+
+        returnData.emplace_back(statistics);
+
+        return returnData;
+    };
+
+    CallFunction(info, p, e, r, true);
 }
 
-NAN_METHOD(HighLevel::RttRead)
+NAN_METHOD(HighLevel::RttOpenWriteQueue)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<RTTReadBaton>();
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<RTTOpenWriteQueueBaton>();
 
-        baton->channelIndex = Convert::getNativeUint32(info[argumentCount]);
+        const auto writeQueueOptions = Convert::getJsObject(parameters[argumentCount]);
+        const WriteQueueOptions options(writeQueueOptions);
         ++argumentCount;
 
-        baton->length = Convert::getNativeUint32(info[argumentCount]);
+        const auto eventCallback = Convert::getCallbackFunction(parameters[argumentCount]);
         ++argumentCount;
 
+        baton->writer = std::make_unique<RttWriter>(options.options, eventCallback);
+
         return baton.release();
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<RTTReadBaton *>(b);
+        auto baton = dynamic_cast<RTTOpenWriteQueueBaton *>(b);
 
-        if (!isRttStarted(b->probe))
+        // The writer keeps using the probe after this call, so it must be held open by rttStart
+        if (!b->session || !isRttStarted(b->probe))
         {
             baton->rttNotStarted = true;
             return INTERNAL_ERROR;
         }
 
-        baton->data.resize(baton->length, 0);
-        uint32_t readLength = 0;
-
-        baton->functionStart = std::chrono::high_resolution_clock::now();
-
-        const auto status =
-            NRFJPROG_rtt_read(b->probe, baton->channelIndex, baton->data.data(), baton->length, &readLength);
+        return b->session->startWriter(baton->writer);
+    };
 
-        if (status != SUCCESS)
-        {
-            rttCleanup(b->probe);
-            return status;
-        }
+    CallFunction(info, p, e, nullptr, true);
+}
 
-        baton->length = readLength;
+NAN_METHOD(HighLevel::RttCloseWriteQueue)
+{
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int &) -> Baton * {
+        auto baton              = std::make_unique<RTTCloseWriteQueueBaton>();
+        baton->unlockedFunction = &HighLevel::interruptRttRecovery;
 
-        return status;
+        return baton.release();
     };
 
-    const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        auto baton = dynamic_cast<RTTReadBaton *>(b);
-
-        std::vector<v8::Local<v8::Value>> returnData;
-
-        returnData.emplace_back(Convert::toJsString(baton->data.data(), baton->length));
-        returnData.emplace_back(
-            Convert::toJsValueArray(reinterpret_cast<uint8_t *>(baton->data.data()), baton->length));
-        returnData.emplace_back(Convert::toTimeDifferenceUS(pHighlvlStatic->rttStartTime, baton->functionStart));
+    const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
+        if (b->session)
+        {
+            b->session->releaseWriter();
+        }
 
-        return returnData;
+        return SUCCESS;
     };
 
-    CallFunction(info, p, e, r, true);
+    CallFunction(info, p, e, nullptr, true);
 }
 
-NAN_METHOD(HighLevel::RttWrite)
+NAN_METHOD(HighLevel::RttQueueWrite)
 {
-    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE, int & argumentCount) -> Baton * {
-        auto baton = std::make_unique<RTTWriteBaton>();
+    const parse_parameters_function_t p = [&](Nan::NAN_METHOD_ARGS_TYPE parameters, int & argumentCount) -> Baton * {
+        auto baton = std::make_unique<RTTQueueWriteBaton>();
 
-        baton->channelIndex = Convert::getNativeUint32(info[argumentCount]);
+        baton->channelIndex = Convert::getNativeUint32(parameters[argumentCount]);
         ++argumentCount;
 
-        if (info[argumentCount]->IsString())
+        if (parameters[argumentCount]->IsString())
         {
-            baton->data   = Convert::getVectorForChar(info[argumentCount]);
-            baton->length = static_cast<uint32_t>(Convert::getNativeString(info[argumentCount]).length());
+            baton->data = Convert::getVectorForChar(parameters[argumentCount]);
         }
         else
         {
-            const auto tempData = Convert::getVectorForUint8(info[argumentCount]);
+            const auto tempData = Convert::getVectorForUint8(parameters[argumentCount]);
             baton->data         = std::vector<char>(tempData.begin(), tempData.end());
-            baton->length       = Convert::getLengthOfArray(info[argumentCount]);
         }
         ++argumentCount;
 
@@ -1579,38 +3513,26 @@ NAN_METHOD(HighLevel::RttWrite)
     };
 
     const execute_function_t e = [&](Baton * b) -> nrfjprogdll_err_t {
-        auto baton = dynamic_cast<RTTWriteBaton *>(b);
-
-        if (!isRttStarted(b->probe))
-        {
-            baton->rttNotStarted = true;
-            return INTERNAL_ERROR;
-        }
-
-        uint32_t writeLength = 0;
-
-        baton->functionStart = std::chrono::high_resolution_clock::now();
-
-        const auto status =
-            NRFJPROG_rtt_write(b->probe, baton->channelIndex, baton->data.data(), baton->length, &writeLength);
+        auto baton = dynamic_cast<RTTQueueWriteBaton *>(b);
 
-        if (status != SUCCESS)
+        if (!b->session ||
+            !b->session->queueWrite(
+                baton->channelIndex, std::move(baton->data), baton->belowHighWaterMark, baton->queuedLength))
         {
-            rttCleanup(b->probe);
-            return status;
+            baton->noWriteQueue = true;
+            return INVALID_OPERATION;
         }
 
-        baton->length = writeLength;
-        return status;
+        return SUCCESS;
     };
 
     const return_function_t r = [&](Baton * b) -> std::vector<v8::Local<v8::Value>> {
-        const auto baton = dynamic_cast<RTTWriteBaton *>(b);
+        auto baton = dynamic_cast<RTTQueueWriteBaton *>(b);
 
         std::vector<v8::Local<v8::Value>> returnData;
 
-        returnData.emplace_back(Convert::toJsNumber(baton->length));
-        returnData.emplace_back(Convert::toTimeDifferenceUS(pHighlvlStatic->rttStartTime, baton->functionStart));
+        returnData.emplace_back(Convert::toJsBool(baton->belowHighWaterMark));
+        returnData.emplace_back(Convert::toJsNumber(baton->queuedLength));
 
         return returnData;
     };
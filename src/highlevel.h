@@ -62,8 +62,40 @@ class HighLevel : public Nan::ObjectWrap
 
     // Async methods
     static NAN_METHOD(GetLibraryVersion);   // Params: callback(error, libraryversion)
-    static NAN_METHOD(GetConnectedDevices); // Params: callback(error, connectedDevices)
-    static NAN_METHOD(GetSerialNumbers);    // Params: callback(error, serialnumbers)
+    static NAN_METHOD(GetConnectedDevices); // Params: [options], callback(error, connectedDevices)
+    static NAN_METHOD(DiscoverDevices);     // Params: [options], callback(error, device), callback(error, deviceCount)
+    static NAN_METHOD(GetSerialNumbers);    // Params: [options], callback(error, serialnumbers)
+
+    static NAN_METHOD(InvalidateDeviceInfo); // Params: [serialnumber], callback(error)
+
+    static NAN_METHOD(StartProbeWatcher);  // Params: options, callback(error, event), callback(error)
+    static NAN_METHOD(StopProbeWatcher);   // Params: callback(error)
+    static NAN_METHOD(SetSimulatedProbes); // Params: serialnumbers, callback(error)
+
+    static NAN_METHOD(StartHealthMonitor); // Params: options, callback(error, health), callback(error)
+    static NAN_METHOD(StopHealthMonitor);  // Params: callback(error)
+    static NAN_METHOD(GetProbeHealth);     // Params: callback(error, health)
+
+    static NAN_METHOD(GetStats);   // Params: callback(error, stats)
+    static NAN_METHOD(ResetStats); // Params: callback(error)
+
+    static NAN_METHOD(SetTimingEnabled); // Params: enabled, callback(error)
+
+    static NAN_METHOD(GetLibraryCallStats);   // Params: callback(error, stats)
+    static NAN_METHOD(ResetLibraryCallStats); // Params: callback(error)
+
+    static NAN_METHOD(GetThroughputStats);   // Params: callback(error, stats)
+    static NAN_METHOD(ResetThroughputStats); // Params: callback(error)
+
+    static NAN_METHOD(SetLogLevel); // Params: level, callback(error)
+    static NAN_METHOD(GetLog);      // Params: [options], callback(error, records)
+
+    static NAN_METHOD(SubscribeLog);   // Params: options, callback(error, records, dropped), callback(error)
+    static NAN_METHOD(UnsubscribeLog); // Params: callback(error)
+
+    static NAN_METHOD(StartTrace); // Params: [options], callback(error)
+    static NAN_METHOD(StopTrace);  // Params: callback(error)
+    static NAN_METHOD(FlushTrace); // Params: filename, callback(error, eventCount)
 
     static NAN_METHOD(GetDeviceInfo);  // Params: serialnumber, callback(error, deviceinfo)
     static NAN_METHOD(GetProbeInfo);   // Params: serialnumber, callback(error, probeinfo)
@@ -97,11 +129,33 @@ class HighLevel : public Nan::ObjectWrap
     static NAN_METHOD(OpenDevice);  // Params: serialnumber, callback(error)
     static NAN_METHOD(CloseDevice); // Params: serialnumber, callback(error)
 
-    static NAN_METHOD(RttStart); // Params: serialNumber, { location }, callback(error, down, up)
+    static NAN_METHOD(RttStart); // Params: serialNumber, { location }, callback(error, down, up, searchtime)
     static NAN_METHOD(RttStop);  // Params: callback(error)
 
     static NAN_METHOD(RttRead);  // Params: channelIndex, callback(error, data, raw, time)
     static NAN_METHOD(RttWrite); // Params: channelIndex, data, callback(error, writtenlength, time)
+    static NAN_METHOD(RttReadMany); // Params: [{ channel, maxLength }], callback(error, buffers, time)
+
+    static NAN_METHOD(RttSubscribe);   // Params: serialNumber, channels, options, callback(error, chunks),
+                                       // callback(error)
+    static NAN_METHOD(RttUnsubscribe); // Params: serialNumber, callback(error)
+
+    static NAN_METHOD(RttCapture);     // Params: serialNumber, channelIndex, path, options,
+                                       // callback(error, statistics), callback(error)
+    static NAN_METHOD(RttStopCapture); // Params: serialNumber, callback(error)
+
+    static NAN_METHOD(RttOpenSharedRing);  // Params: serialNumber, channelIndex, sharedArrayBuffer, options,
+                                           // callback(error), callback(error)
+    static NAN_METHOD(RttCloseSharedRing); // Params: serialNumber, callback(error)
+
+    static NAN_METHOD(RttGetBufferStatistics);  // Params: serialNumber, callback(error, statistics)
+    static NAN_METHOD(RttGetSessionStatistics); // Params: serialNumber, callback(error, statistics)
+
+    static NAN_METHOD(RttOpenWriteQueue);  // Params: serialNumber, options, callback(error, channelIndex),
+                                           // callback(error)
+    static NAN_METHOD(RttCloseWriteQueue); // Params: serialNumber, callback(error)
+    static NAN_METHOD(RttQueueWrite);      // Params: serialNumber, channelIndex, data,
+                                           // callback(error, belowHighWaterMark, queuedLength)
 
     static void CallFunction(Nan::NAN_METHOD_ARGS_TYPE info,
                              const parse_parameters_function_t &parse,
@@ -110,20 +164,41 @@ class HighLevel : public Nan::ObjectWrap
     );
     static void ExecuteFunction(uv_work_t *req);
     static void ReturnFunction(uv_work_t *req);
+    static void RescheduleFunction(Baton *baton);
 
     static void init(v8::Local<v8::FunctionTemplate> target);
 
+    // Messages from the nrfjprog library
     static void log(const char *msg);
+    // Errors of this module
     static void log(const std::string &msg);
-    static void resetLog();
 
     static void progressCallback(const char *process);
     static void sendProgress(uv_async_t *handle);
 
+    // Lists the probes under the execution mutex, and sets the result of the baton if that fails
+    static bool listProbesLocked(Baton *baton, std::vector<uint32_t> & serialNumbers);
+    // Reads the probes without the execution mutex, each one only locks the lane of its RTT session
+    static std::vector<ProbeEnumerationResult>
+    enumerateConnectedProbes(const std::vector<uint32_t> & connectedSerialNumbers, const EnumerationOptions & options,
+                             const std::function<void(const ProbeEnumerationResult &)> & onResult);
+
+    // Locks the lane of the RTT session of the probe, if it has one
+    static bool lockRttLane(uint32_t serialNumber, std::unique_lock<std::timed_mutex> & laneLock);
+    // Closes the probe and its RTT session after it is detached, with the execution mutex held
+    static void forgetProbe(uint32_t serialNumber);
+    // Checks that the probe responds, without the execution mutex
+    static nrfjprogdll_err_t checkProbeHealth(uint32_t serialNumber, std::chrono::microseconds & latency);
+
     static bool isRttStarted(Probe_handle_t probe);
-    static nrfjprogdll_err_t waitForControlBlock(Probe_handle_t probe, bool &isControlBlockFound);
+    static nrfjprogdll_err_t pollControlBlock(RTTStartBaton *baton);
+    static nrfjprogdll_err_t enableRecovery(RTTStartBaton *baton);
+    static nrfjprogdll_err_t startBuffering(RTTStartBaton *baton);
     static nrfjprogdll_err_t getChannelInformation(RTTStartBaton *baton, bool &isChannelInformationAvailable);
     static nrfjprogdll_err_t rttCleanup(Probe_handle_t probe);
+    // Unlocked functions that stop a recovery from holding the lane the function waits for
+    static bool interruptRttRecovery(Baton *baton);
+    static bool stopRttRecovery(Baton *baton);
 };
 
 #endif // __NRFJPROG_H__
@@ -39,6 +39,14 @@
 
 #include "highlevel_common.h"
 #include "highlevel_helpers.h"
+#include "log_subscriber.h"
+#include "operation_timing.h"
+#include "probe_discovery.h"
+#include "probe_health.h"
+#include "probe_watcher.h"
+#include "rtt_reader.h"
+#include "rtt_session.h"
+#include "rtt_writer.h"
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -58,6 +66,8 @@ class Baton
         , probe(_probe)
         , lowlevelError(SUCCESS)
         , cpuNeedsReset(false)
+        , rescheduleDelay(0)
+        , runsOnSessionLane(false)
     {
         req       = std::make_unique<uv_work_t>();
         req->data = static_cast<void *>(this);
@@ -83,9 +93,28 @@ class Baton
 
     std::chrono::high_resolution_clock::time_point functionStart;
 
+    // Where the time went between queueing the function and calling the callback
+    BatonTiming timing;
+    // Ties the waits of the function together in the trace
+    uint64_t traceId{0};
+    // The first log record of the function
+    uint64_t logStart{0};
+
+    // Set by the execute function to run it again after the delay, without holding the execution lane in between
+    std::chrono::milliseconds rescheduleDelay;
+
+    // The RTT session of the probe, if open. Batons that run on the session lane
+    // only lock the lane of the session instead of the global execution mutex.
+    bool runsOnSessionLane;
+    std::shared_ptr<RttSession> session;
+
     std::unique_ptr<uv_work_t> req;
     std::unique_ptr<Nan::Callback> callback;
 
+    // If set, runs first without the execution mutex, a session lane or the probe. When it returns true
+    // the function is done, for instance when the device info cache has the result, or for functions
+    // that only touch state with its own locking. The execute function may then be left empty.
+    unlocked_function_t unlockedFunction;
     execute_function_t executeFunction;
     return_function_t returnFunction;
 
@@ -105,6 +134,16 @@ class BatonNeedsReset : public Baton
       }
 };
 
+class RttBaton : public Baton
+{
+  public:
+    RttBaton(const std::string _name, const uint32_t _returnParameterCount)
+        : Baton(_name, _returnParameterCount, false)
+    {
+        runsOnSessionLane = true;
+    }
+};
+
 class GetLibraryVersionBaton : public Baton
 {
   public:
@@ -122,15 +161,224 @@ class GetConnectedDevicesBaton : public Baton
     GetConnectedDevicesBaton()
         : Baton("get connected devices", 1, false)
     {}
+    EnumerationOptions options;
     std::vector<std::unique_ptr<ProbeDetails>> probes;
 };
 
+class DiscoverDevicesBaton : public Baton
+{
+  public:
+    DiscoverDevicesBaton()
+        : Baton("discover devices", 1, false)
+        , deviceCount(0)
+    {}
+    EnumerationOptions options;
+    std::unique_ptr<ProbeDiscovery> discovery;
+    uint32_t deviceCount;
+};
+
+class InvalidateDeviceInfoBaton : public Baton
+{
+  public:
+    InvalidateDeviceInfoBaton()
+        : Baton("invalidate device info", 0, false)
+        , invalidatedSerialNumber(0)
+    {}
+    uint32_t invalidatedSerialNumber; // 0 invalidates all devices
+};
+
+class StartProbeWatcherBaton : public Baton
+{
+  public:
+    StartProbeWatcherBaton()
+        : Baton("start probe watcher", 0, false)
+    {}
+    std::unique_ptr<ProbeWatcher> watcher;
+};
+
+class StopProbeWatcherBaton : public Baton
+{
+  public:
+    StopProbeWatcherBaton()
+        : Baton("stop probe watcher", 0, false)
+    {}
+    std::unique_ptr<ProbeWatcher> watcher; // Deleted with the baton, on the JS thread
+};
+
+class SetSimulatedProbesBaton : public Baton
+{
+  public:
+    SetSimulatedProbesBaton()
+        : Baton("set simulated probes", 0, false)
+    {}
+    std::vector<uint32_t> serialNumbers;
+};
+
+class StartHealthMonitorBaton : public Baton
+{
+  public:
+    StartHealthMonitorBaton()
+        : Baton("start health monitor", 0, false)
+    {}
+    std::unique_ptr<ProbeHealthMonitor> monitor;
+};
+
+class StopHealthMonitorBaton : public Baton
+{
+  public:
+    StopHealthMonitorBaton()
+        : Baton("stop health monitor", 0, false)
+    {}
+    std::unique_ptr<ProbeHealthMonitor> monitor; // Deleted with the baton, on the JS thread
+};
+
+class GetProbeHealthBaton : public Baton
+{
+  public:
+    GetProbeHealthBaton()
+        : Baton("get probe health", 1, false)
+        , monitorStarted(false)
+    {}
+    bool monitorStarted;
+    std::vector<ProbeHealth> health;
+};
+
+class GetLibraryCallStatsBaton : public Baton
+{
+  public:
+    GetLibraryCallStatsBaton()
+        : Baton("get library call stats", 1, false)
+    {}
+    LibraryCallStatistics::function_map_t functions;
+    std::map<uint32_t, LibraryCallStatistics::function_map_t> serialNumbers;
+};
+
+class ResetLibraryCallStatsBaton : public Baton
+{
+  public:
+    ResetLibraryCallStatsBaton()
+        : Baton("reset library call stats", 0, false)
+    {}
+};
+
+class GetThroughputStatsBaton : public Baton
+{
+  public:
+    GetThroughputStatsBaton()
+        : Baton("get throughput stats", 1, false)
+    {}
+    std::map<uint32_t, ThroughputCounters::counters_t> serialNumbers;
+};
+
+class ResetThroughputStatsBaton : public Baton
+{
+  public:
+    ResetThroughputStatsBaton()
+        : Baton("reset throughput stats", 0, false)
+    {}
+};
+
+class SetTimingEnabledBaton : public Baton
+{
+  public:
+    SetTimingEnabledBaton()
+        : Baton("set timing enabled", 0, false)
+        , enabled(false)
+    {}
+    bool enabled;
+};
+
+class SetLogLevelBaton : public Baton
+{
+  public:
+    SetLogLevelBaton()
+        : Baton("set log level", 0, false)
+        , level(LOG_LEVEL_DEBUG)
+    {}
+    log_level_t level;
+};
+
+class GetLogBaton : public Baton
+{
+  public:
+    GetLogBaton()
+        : Baton("get log", 1, false)
+    {}
+    LogOptions options;
+    std::vector<LogRing::Record> records;
+};
+
+class SubscribeLogBaton : public Baton
+{
+  public:
+    SubscribeLogBaton()
+        : Baton("subscribe log", 0, false)
+    {}
+    std::unique_ptr<LogSubscriber> subscriber; // Kept by the baton if there already is a subscription
+};
+
+class UnsubscribeLogBaton : public Baton
+{
+  public:
+    UnsubscribeLogBaton()
+        : Baton("unsubscribe log", 0, false)
+    {}
+    std::unique_ptr<LogSubscriber> subscriber; // Deleted with the baton, on the JS thread
+};
+
+class StartTraceBaton : public Baton
+{
+  public:
+    StartTraceBaton()
+        : Baton("start trace", 0, false)
+    {}
+    TraceOptions options;
+};
+
+class StopTraceBaton : public Baton
+{
+  public:
+    StopTraceBaton()
+        : Baton("stop trace", 0, false)
+    {}
+};
+
+class FlushTraceBaton : public Baton
+{
+  public:
+    FlushTraceBaton()
+        : Baton("flush trace", 1, false)
+        , eventCount(0)
+    {}
+    std::string filename;
+    size_t eventCount;
+};
+
+class GetStatsBaton : public Baton
+{
+  public:
+    GetStatsBaton()
+        : Baton("get stats", 1, false)
+    {}
+    std::map<std::string, OperationStatistics::Entry> methods;
+    std::map<uint32_t, OperationStatistics::Entry> serialNumbers;
+};
+
+class ResetStatsBaton : public Baton
+{
+  public:
+    ResetStatsBaton()
+        : Baton("reset stats", 0, false)
+    {}
+};
+
 class GetSerialNumbersBaton : public Baton
 {
   public:
     GetSerialNumbersBaton()
         : Baton("get serial numbers", 1, false)
     {}
+    EnumerationOptions options;
     std::vector<uint32_t> serialNumbers;
 };
 
@@ -323,11 +571,17 @@ class CloseBaton : public BatonNeedsReset
     {}
 };
 
-class RTTStartBaton : public Baton
+class RTTStartBaton : public RttBaton
 {
   public:
     RTTStartBaton()
-        : Baton("start rtt", 2, false)
+        : RttBaton("start rtt", 3)
+        , searchStarted(false)
+        , reset(true)
+        , hasSearchRange(false)
+        , searchRangeStart(0)
+        , searchRangeLength(0)
+        , autoRecover(false)
     {}
     std::string toString()
     {
@@ -337,15 +591,36 @@ class RTTStartBaton : public Baton
         stream << "Serialnumber: " << serialNumber << std::endl;
         stream << "Has Controlblock: " << (hasControlBlockLocation ? "true" : "false") << std::endl;
         stream << "Controlblock location: " << controlBlockLocation << std::endl;
+        stream << "Search timeout: " << searchOptions.timeout.count() << "ms" << std::endl;
+        stream << "Buffer size: " << bufferSize << std::endl;
+        stream << "Reset: " << (reset ? "true" : "false") << std::endl;
+        stream << "Search range: " << searchRangeStart << " + " << searchRangeLength << std::endl;
+        stream << "ELF path: " << elfPath << std::endl;
+        stream << "Auto recover: " << (autoRecover ? "true" : "false") << std::endl;
 
         return stream.str();
     }
 
-    uint32_t serialNumber;
     bool hasControlBlockLocation;
     bool foundControlBlock;
     uint32_t controlBlockLocation;
 
+    ControlBlockSearchOptions searchOptions;
+    bool searchStarted;
+    std::chrono::milliseconds searchInterval;
+    std::chrono::high_resolution_clock::time_point searchStartTime;
+    std::chrono::high_resolution_clock::time_point searchEndTime;
+
+    uint32_t bufferSize;
+
+    bool reset;
+    bool hasSearchRange;
+    uint32_t searchRangeStart;
+    uint32_t searchRangeLength;
+    std::string elfPath;
+
+    bool autoRecover;
+
     uint32_t clockSpeed;
     device_family_t family;
     std::string jlinkarmlocation;
@@ -355,11 +630,11 @@ class RTTStartBaton : public Baton
     std::vector<std::unique_ptr<ChannelInfo>> downChannelInfo;
 };
 
-class RTTStopBaton : public Baton
+class RTTStopBaton : public RttBaton
 {
   public:
     RTTStopBaton()
-        : Baton("stop rtt", 0, false)
+        : RttBaton("stop rtt", 0)
     {}
     std::string toString()
     {
@@ -369,11 +644,11 @@ class RTTStopBaton : public Baton
     bool rttNotStarted;
 };
 
-class RTTReadBaton : public Baton
+class RTTReadBaton : public RttBaton
 {
   public:
     RTTReadBaton()
-        : Baton("rtt read", 3, false)
+        : RttBaton("rtt read", 3)
     {}
     std::string toString()
     {
@@ -394,11 +669,46 @@ class RTTReadBaton : public Baton
     bool rttNotStarted;
 };
 
-class RTTWriteBaton : public Baton
+class RTTReadManyBaton : public RttBaton
+{
+  public:
+    RTTReadManyBaton()
+        : RttBaton("rtt read many", 2)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        for (const auto & channel : channels)
+        {
+            stream << "ChannelIndex: " << channel.channelIndex << " Length wanted: " << channel.maxLength
+                   << std::endl;
+        }
+        stream << "RTT not started: " << rttNotStarted;
+
+        return stream.str();
+    }
+
+    struct ChannelRead
+    {
+        uint32_t channelIndex;
+        uint32_t maxLength;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    std::vector<ChannelRead> channels;
+    std::vector<char> data;
+
+    bool rttNotStarted;
+};
+
+class RTTWriteBaton : public RttBaton
 {
   public:
     RTTWriteBaton()
-        : Baton("rtt write", 2, false)
+        : RttBaton("rtt write", 2)
     {}
     std::string toString()
     {
@@ -419,4 +729,223 @@ class RTTWriteBaton : public Baton
     bool rttNotStarted;
 };
 
+class RTTSubscribeBaton : public RttBaton
+{
+  public:
+    RTTSubscribeBaton()
+        : RttBaton("rtt subscribe", 0)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "Channels: " << channelCount << std::endl;
+        stream << "RTT not started: " << rttNotStarted;
+
+        return stream.str();
+    }
+
+    size_t channelCount;
+    std::unique_ptr<RttReader> reader;
+
+    bool rttNotStarted;
+};
+
+class RTTUnsubscribeBaton : public RttBaton
+{
+  public:
+    RTTUnsubscribeBaton()
+        : RttBaton("rtt unsubscribe", 0)
+    {}
+    std::string toString()
+    {
+        return "No parameters";
+    }
+};
+
+class RTTCaptureBaton : public RttBaton
+{
+  public:
+    RTTCaptureBaton()
+        : RttBaton("rtt capture", 0)
+        , rttNotStarted(false)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "ChannelIndex: " << channelIndex << std::endl;
+        stream << "Path: " << path << std::endl;
+        stream << "RTT not started: " << rttNotStarted;
+
+        return stream.str();
+    }
+
+    uint32_t channelIndex;
+    std::string path;
+    std::unique_ptr<RttReader> reader;
+
+    bool rttNotStarted;
+};
+
+class RTTStopCaptureBaton : public RttBaton
+{
+  public:
+    RTTStopCaptureBaton()
+        : RttBaton("rtt stop capture", 0)
+    {}
+    std::string toString()
+    {
+        return "No parameters";
+    }
+};
+
+class RTTOpenSharedRingBaton : public RttBaton
+{
+  public:
+    RTTOpenSharedRingBaton()
+        : RttBaton("rtt open shared ring", 0)
+        , rttNotStarted(false)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "ChannelIndex: " << channelIndex << std::endl;
+        stream << "Ring length: " << length << std::endl;
+        stream << "RTT not started: " << rttNotStarted;
+
+        return stream.str();
+    }
+
+    uint32_t channelIndex;
+    size_t length;
+    std::unique_ptr<RttReader> reader;
+
+    bool rttNotStarted;
+};
+
+class RTTCloseSharedRingBaton : public RttBaton
+{
+  public:
+    RTTCloseSharedRingBaton()
+        : RttBaton("rtt close shared ring", 0)
+    {}
+    std::string toString()
+    {
+        return "No parameters";
+    }
+};
+
+class RTTGetBufferStatisticsBaton : public RttBaton
+{
+  public:
+    RTTGetBufferStatisticsBaton()
+        : RttBaton("rtt get buffer statistics", 1)
+        , rttNotBuffered(false)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "Buffered channels: " << statistics.size() << std::endl;
+        stream << "RTT not buffered: " << rttNotBuffered;
+
+        return stream.str();
+    }
+
+    std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> statistics;
+
+    bool rttNotBuffered;
+};
+
+class RTTGetSessionStatisticsBaton : public RttBaton
+{
+  public:
+    RTTGetSessionStatisticsBaton()
+        : RttBaton("rtt get session statistics", 1)
+        , upChannelCount(0)
+        , downChannelCount(0)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "Serialnumber: " << serialNumber;
+
+        return stream.str();
+    }
+
+    RttRecoveryStatistics recovery;
+    size_t upChannelCount;
+    size_t downChannelCount;
+};
+
+class RTTOpenWriteQueueBaton : public RttBaton
+{
+  public:
+    RTTOpenWriteQueueBaton()
+        : RttBaton("rtt open write queue", 0)
+        , rttNotStarted(false)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "RTT not started: " << rttNotStarted;
+
+        return stream.str();
+    }
+
+    std::unique_ptr<RttWriter> writer;
+
+    bool rttNotStarted;
+};
+
+class RTTCloseWriteQueueBaton : public RttBaton
+{
+  public:
+    RTTCloseWriteQueueBaton()
+        : RttBaton("rtt close write queue", 0)
+    {}
+    std::string toString()
+    {
+        return "No parameters";
+    }
+};
+
+class RTTQueueWriteBaton : public RttBaton
+{
+  public:
+    RTTQueueWriteBaton()
+        : RttBaton("rtt queue write", 2)
+        , noWriteQueue(false)
+    {}
+    std::string toString()
+    {
+        std::stringstream stream;
+
+        stream << "Parameters:" << std::endl;
+        stream << "ChannelIndex: " << channelIndex << std::endl;
+        stream << "Length: " << data.size() << std::endl;
+        stream << "No write queue: " << noWriteQueue;
+
+        return stream.str();
+    }
+
+    uint32_t channelIndex;
+    std::vector<char> data;
+
+    bool belowHighWaterMark;
+    uint32_t queuedLength;
+
+    bool noWriteQueue;
+};
+
 #endif
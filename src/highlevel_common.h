@@ -58,6 +58,58 @@ typedef enum
     INPUT_FORMAT_HEX_STRING
 } input_format_t;
 
+typedef enum
+{
+    RTT_FRAMING_NONE,
+    RTT_FRAMING_LINE,
+    RTT_FRAMING_LENGTH_PREFIX
+} rtt_framing_t;
+
+// What the background reader of an RTT session does with the data, a session has one reader at a time
+typedef enum
+{
+    RTT_READER_SUBSCRIPTION, // rttSubscribe
+    RTT_READER_BUFFER,       // rttStart with a bufferSize
+    RTT_READER_CAPTURE,      // rttCapture
+    RTT_READER_SHARED_RING   // rttOpenSharedRing
+} rtt_reader_kind_t;
+
+// The information that is read for each probe when enumerating, every level includes the previous ones
+typedef enum
+{
+    ENUMERATE_SERIAL_NUMBERS,
+    ENUMERATE_PROBE_INFO, // Probe and library information, without connecting to the target
+    ENUMERATE_ALL_INFO
+} enumeration_fields_t;
+
+// The level of a log record, records below the log level are not kept
+typedef enum
+{
+    LOG_LEVEL_TRACE,
+    LOG_LEVEL_DEBUG, // Messages from the nrfjprog library
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_NONE
+} log_level_t;
+
+// The 32 bit words at the start of a SharedArrayBuffer RTT ring
+typedef enum
+{
+    RTT_SHARED_RING_WRITE_INDEX,
+    RTT_SHARED_RING_READ_INDEX,
+    RTT_SHARED_RING_DROPPED,
+    RTT_SHARED_RING_STATE,
+    RTT_SHARED_RING_HEADER_WORDS
+} rtt_shared_ring_word_t;
+
+typedef enum
+{
+    RTT_SHARED_RING_RUNNING,
+    RTT_SHARED_RING_STOPPED,
+    RTT_SHARED_RING_FAILED
+} rtt_shared_ring_state_t;
+
 typedef enum
 {
     JsSuccess,
@@ -124,6 +176,8 @@ class Baton;
 
 typedef std::function<Baton *(Nan::NAN_METHOD_ARGS_TYPE, int &)> parse_parameters_function_t;
 typedef std::function<nrfjprogdll_err_t(Baton *)> execute_function_t;
+typedef std::function<bool(Baton *)> unlocked_function_t;
 typedef std::function<std::vector<v8::Local<v8::Value>>(Baton *)> return_function_t;
+typedef std::function<nrfjprogdll_err_t(nrfjprogdll_err_t)> rtt_recovery_function_t;
 
 #endif // __NRFJPROG_COMMON_H__
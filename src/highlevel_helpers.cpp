@@ -36,7 +36,11 @@
 
 #include "highlevel_helpers.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "utility/conversion.h"
+#include "utility/errormessage.h"
 #include "utility/utility.h"
 
 v8::Local<v8::Object> ProbeDetails::ToJs()
@@ -45,9 +49,236 @@ v8::Local<v8::Object> ProbeDetails::ToJs()
     v8::Local<v8::Object> obj = Nan::New<v8::Object>();
 
     Utility::Set(obj, "serialNumber", Convert::toJsNumber(serial_number));
-    Utility::Set(obj, "deviceInfo", DeviceInfo(device_info).ToJs());
-    Utility::Set(obj, "probeInfo", ProbeInfo(probe_info).ToJs());
-    Utility::Set(obj, "libraryInfo", LibraryInfo(library_info).ToJs());
+
+    if (fields == ENUMERATE_ALL_INFO)
+    {
+        Utility::Set(obj, "deviceInfo", DeviceInfo(device_info).ToJs());
+    }
+
+    if (fields != ENUMERATE_SERIAL_NUMBERS)
+    {
+        Utility::Set(obj, "probeInfo", ProbeInfo(probe_info).ToJs());
+        Utility::Set(obj, "libraryInfo", LibraryInfo(library_info).ToJs());
+    }
+
+    Utility::Set(obj, "enumerationTime", Convert::toJsNumber(static_cast<double>(duration.count())));
+    Utility::Set(obj, "cached", Convert::toJsBool(cached));
+
+    if (error != SUCCESS)
+    {
+        Utility::Set(obj,
+                     "error",
+                     ErrorMessage::getErrorMessage(CouldNotCallFunction, nrfjprog_js_err_map, failed_step, "", error));
+    }
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> TimingInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    Utility::Set(obj, "queueWait", Convert::toJsNumber(static_cast<double>(timing.queueWait.count())));
+    Utility::Set(obj, "lockWait", Convert::toJsNumber(static_cast<double>(timing.lockWait.count())));
+    Utility::Set(obj, "probeInit", Convert::toJsNumber(static_cast<double>(timing.probeInit.count())));
+    Utility::Set(obj, "operation", Convert::toJsNumber(static_cast<double>(timing.operation.count())));
+    Utility::Set(obj, "cleanup", Convert::toJsNumber(static_cast<double>(timing.cleanup.count())));
+    Utility::Set(obj, "returnConversion", Convert::toJsNumber(static_cast<double>(timing.returnConversion.count())));
+    Utility::Set(obj, "total", Convert::toJsNumber(static_cast<double>(timing.total.count())));
+    Utility::Set(obj, "executions", Convert::toJsNumber(timing.executions));
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> OperationStatisticsInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj              = Nan::New<v8::Object>();
+    v8::Local<v8::Object> methodsObj       = Nan::New<v8::Object>();
+    v8::Local<v8::Object> serialNumbersObj = Nan::New<v8::Object>();
+
+    for (const auto & method : methods)
+    {
+        Utility::Set(methodsObj, method.first.c_str(), EntryToJs(method.second));
+    }
+
+    for (const auto & serialNumber : serialNumbers)
+    {
+        Utility::Set(serialNumbersObj, std::to_string(serialNumber.first).c_str(), EntryToJs(serialNumber.second));
+    }
+
+    Utility::Set(obj, "methods", methodsObj);
+    Utility::Set(obj, "serialNumbers", serialNumbersObj);
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> OperationStatisticsInfo::EntryToJs(const OperationStatistics::Entry & entry)
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    const auto phaseToJs = [&entry](const OperationStatistics::Phase & phase) -> v8::Local<v8::Object> {
+        v8::Local<v8::Object> phaseObj = Nan::New<v8::Object>();
+        const auto count   = std::max<uint64_t>(entry.count, 1);
+        const auto average = static_cast<double>(phase.sum.count()) / static_cast<double>(count);
+
+        Utility::Set(phaseObj, "average", Convert::toJsNumber(average));
+        Utility::Set(phaseObj, "max", Convert::toJsNumber(static_cast<double>(phase.max.count())));
+
+        return phaseObj;
+    };
+
+    Utility::Set(obj, "count", Convert::toJsNumber(static_cast<double>(entry.count)));
+    Utility::Set(obj, "errors", Convert::toJsNumber(static_cast<double>(entry.errors)));
+    Utility::Set(obj, "queueWait", phaseToJs(entry.queueWait));
+    Utility::Set(obj, "lockWait", phaseToJs(entry.lockWait));
+    Utility::Set(obj, "probeInit", phaseToJs(entry.probeInit));
+    Utility::Set(obj, "operation", phaseToJs(entry.operation));
+    Utility::Set(obj, "cleanup", phaseToJs(entry.cleanup));
+    Utility::Set(obj, "returnConversion", phaseToJs(entry.returnConversion));
+    Utility::Set(obj, "total", phaseToJs(entry.total));
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> LibraryCallStatisticsInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj              = Nan::New<v8::Object>();
+    v8::Local<v8::Object> serialNumbersObj = Nan::New<v8::Object>();
+
+    for (const auto & serialNumber : serialNumbers)
+    {
+        Utility::Set(serialNumbersObj, std::to_string(serialNumber.first).c_str(), FunctionsToJs(serialNumber.second));
+    }
+
+    Utility::Set(obj, "functions", FunctionsToJs(functions));
+    Utility::Set(obj, "serialNumbers", serialNumbersObj);
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> LibraryCallStatisticsInfo::FunctionsToJs(const LibraryCallStatistics::function_map_t & entries)
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    for (const auto & entry : entries)
+    {
+        Utility::Set(obj, entry.first.c_str(), EntryToJs(entry.second));
+    }
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> LibraryCallStatisticsInfo::EntryToJs(const LibraryCallStatistics::Entry & entry)
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj           = Nan::New<v8::Object>();
+    v8::Local<v8::Object> errorCodesObj = Nan::New<v8::Object>();
+    v8::Local<v8::Array> histogramArray = Nan::New<v8::Array>(static_cast<uint32_t>(entry.histogram.size()));
+
+    const auto count   = std::max<uint64_t>(entry.count, 1);
+    const auto average = static_cast<double>(entry.total.count()) / static_cast<double>(count);
+
+    for (const auto & errorCode : entry.errorCodes)
+    {
+        const auto name = std::to_string(errorCode.first);
+        const auto code = static_cast<uint16_t>(errorCode.first);
+
+        Utility::Set(errorCodesObj,
+                     Convert::valueToString(code, nrfjprogdll_err_map, name.c_str()),
+                     Convert::toJsNumber(static_cast<double>(errorCode.second)));
+    }
+
+    for (uint32_t i = 0; i < entry.histogram.size(); ++i)
+    {
+        Nan::Set(histogramArray, Convert::toJsNumber(i), Convert::toJsNumber(static_cast<double>(entry.histogram[i])));
+    }
+
+    Utility::Set(obj, "count", Convert::toJsNumber(static_cast<double>(entry.count)));
+    Utility::Set(obj, "errors", Convert::toJsNumber(static_cast<double>(entry.errors)));
+    Utility::Set(obj, "average", Convert::toJsNumber(average));
+    Utility::Set(obj, "max", Convert::toJsNumber(static_cast<double>(entry.max.count())));
+    Utility::Set(obj, "errorCodes", errorCodesObj);
+    Utility::Set(obj, "histogram", histogramArray);
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> ThroughputInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    for (const auto & serialNumber : serialNumbers)
+    {
+        const auto & counters             = serialNumber.second;
+        v8::Local<v8::Object> countersObj = Nan::New<v8::Object>();
+
+        Utility::Set(countersObj, "read", CounterToJs(counters[THROUGHPUT_READ]));
+        Utility::Set(countersObj, "write", CounterToJs(counters[THROUGHPUT_WRITE]));
+        Utility::Set(countersObj, "program", CounterToJs(counters[THROUGHPUT_PROGRAM]));
+        Utility::Set(countersObj, "verify", CounterToJs(counters[THROUGHPUT_VERIFY]));
+        Utility::Set(countersObj, "rttUp", CounterToJs(counters[THROUGHPUT_RTT_UP]));
+        Utility::Set(countersObj, "rttDown", CounterToJs(counters[THROUGHPUT_RTT_DOWN]));
+
+        Utility::Set(obj, std::to_string(serialNumber.first).c_str(), countersObj);
+    }
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> ThroughputInfo::CounterToJs(const ThroughputCounters::Counter & counter)
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    // Bytes per second over the time the transfers took, not over the wall time in between
+    const auto seconds = static_cast<double>(counter.time.count()) / 1000000.0;
+    const auto rate    = seconds > 0 ? static_cast<double>(counter.bytes) / seconds : 0.0;
+
+    Utility::Set(obj, "bytes", Convert::toJsNumber(static_cast<double>(counter.bytes)));
+    Utility::Set(obj, "transfers", Convert::toJsNumber(static_cast<double>(counter.transfers)));
+    Utility::Set(obj, "time", Convert::toJsNumber(static_cast<double>(counter.time.count())));
+    Utility::Set(obj, "rate", Convert::toJsNumber(rate));
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> LogRecordInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    Utility::Set(obj, "sequence", Convert::toJsNumber(static_cast<double>(record.sequence)));
+    Utility::Set(obj, "level", Convert::toJsNumber(static_cast<uint32_t>(record.level)));
+    Utility::Set(obj, "timestamp", Convert::toJsNumber(static_cast<double>(record.timestamp) / 1000.0));
+    Utility::Set(obj, "serialNumber", Convert::toJsNumber(record.serialNumber));
+    Utility::Set(obj, "message", Convert::toJsString(record.message));
+
+    return scope.Escape(obj);
+}
+
+v8::Local<v8::Object> ProbeHealthInfo::ToJs()
+{
+    Nan::EscapableHandleScope scope;
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    const auto lastCheck =
+        std::chrono::duration_cast<std::chrono::milliseconds>(health.lastCheck.time_since_epoch()).count();
+
+    Utility::Set(obj, "serialNumber", Convert::toJsNumber(health.serialNumber));
+    Utility::Set(obj, "healthy", Convert::toJsBool(health.healthy));
+    Utility::Set(obj, "consecutiveFailures", Convert::toJsNumber(health.consecutiveFailures));
+    Utility::Set(obj, "checks", Convert::toJsNumber(health.checks));
+    Utility::Set(obj, "failures", Convert::toJsNumber(health.failures));
+    Utility::Set(obj, "lastError", Convert::toJsNumber(static_cast<int32_t>(health.lastError)));
+    Utility::Set(obj, "lastLatency", Convert::toJsNumber(static_cast<double>(health.lastLatency.count())));
+    Utility::Set(obj, "averageLatency", Convert::toJsNumber(static_cast<double>(health.averageLatency.count())));
+    Utility::Set(obj, "lastCheck", Convert::toJsNumber(static_cast<double>(lastCheck)));
 
     return scope.Escape(obj);
 }
@@ -227,10 +458,383 @@ v8::Local<v8::Object> ChannelInfo::ToJs()
 StartOptions::StartOptions(v8::Local<v8::Object> obj)
 {
     hasControlBlockLocation = false;
+    bufferSize              = 0;
+    reset                   = true;
+    hasSearchRange          = false;
+    autoRecover             = false;
 
     if (Utility::Has(obj, "controlBlockLocation"))
     {
         hasControlBlockLocation = true;
         controlBlockLocation    = Convert::getNativeUint32(obj, "controlBlockLocation");
     }
+
+    if (Utility::Has(obj, "searchInitialInterval"))
+    {
+        searchOptions.initialInterval =
+            std::chrono::milliseconds(Convert::getNativeUint32(obj, "searchInitialInterval"));
+    }
+
+    if (Utility::Has(obj, "searchMaxInterval"))
+    {
+        searchOptions.maxInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "searchMaxInterval"));
+    }
+
+    if (Utility::Has(obj, "searchTimeout"))
+    {
+        searchOptions.timeout = std::chrono::milliseconds(Convert::getNativeUint32(obj, "searchTimeout"));
+    }
+
+    if (Utility::Has(obj, "bufferSize"))
+    {
+        bufferSize = Convert::getNativeUint32(obj, "bufferSize");
+    }
+
+    if (Utility::Has(obj, "reset"))
+    {
+        reset = Convert::getNativeBool(obj, "reset") != 0;
+    }
+
+    if (Utility::Has(obj, "searchRangeStart") || Utility::Has(obj, "searchRangeLength"))
+    {
+        hasSearchRange    = true;
+        searchRangeStart  = Convert::getNativeUint32(obj, "searchRangeStart");
+        searchRangeLength = Convert::getNativeUint32(obj, "searchRangeLength");
+    }
+
+    if (Utility::Has(obj, "elfPath"))
+    {
+        elfPath = Convert::getNativeString(obj, "elfPath");
+    }
+
+    if (Utility::Has(obj, "autoRecover"))
+    {
+        autoRecover = Convert::getNativeBool(obj, "autoRecover") != 0;
+    }
+
+    // The interval doubles after every poll, so it can never start at zero
+    searchOptions.initialInterval = std::max(searchOptions.initialInterval, std::chrono::milliseconds(1));
+    searchOptions.maxInterval     = std::max(searchOptions.maxInterval, searchOptions.initialInterval);
+}
+
+SubscribeOptions::SubscribeOptions(v8::Local<v8::Object> obj)
+{
+    if (Utility::Has(obj, "minPollInterval"))
+    {
+        options.minPollInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "minPollInterval"));
+    }
+
+    if (Utility::Has(obj, "maxPollInterval"))
+    {
+        options.maxPollInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "maxPollInterval"));
+    }
+
+    if (Utility::Has(obj, "readLength"))
+    {
+        options.readLength = Convert::getNativeUint32(obj, "readLength");
+    }
+
+    if (Utility::Has(obj, "framing"))
+    {
+        options.framing.mode = static_cast<rtt_framing_t>(Convert::getNativeUint32(obj, "framing"));
+    }
+
+    if (Utility::Has(obj, "lengthPrefixSize"))
+    {
+        options.framing.lengthPrefixSize = Convert::getNativeUint32(obj, "lengthPrefixSize");
+    }
+
+    if (Utility::Has(obj, "maxLineLength"))
+    {
+        options.framing.maxLineLength = Convert::getNativeUint32(obj, "maxLineLength");
+    }
+
+    if (Utility::Has(obj, "maxRecordLength"))
+    {
+        options.framing.maxRecordLength = Convert::getNativeUint32(obj, "maxRecordLength");
+    }
+
+    // The poll interval doubles while the channels are idle, so it can never start at zero
+    options.minPollInterval = std::max(options.minPollInterval, std::chrono::milliseconds(1));
+    options.maxPollInterval = std::max(options.maxPollInterval, options.minPollInterval);
+
+    if (options.readLength == 0)
+    {
+        throw std::runtime_error("Failed to get property readLength: must be larger than zero");
+    }
+
+    if (options.framing.mode > RTT_FRAMING_LENGTH_PREFIX)
+    {
+        throw std::runtime_error("Failed to get property framing: unknown framing mode");
+    }
+
+    if (options.framing.lengthPrefixSize == 0 || options.framing.lengthPrefixSize > 4)
+    {
+        throw std::runtime_error("Failed to get property lengthPrefixSize: must be between 1 and 4");
+    }
+
+    if (options.framing.maxLineLength == 0)
+    {
+        throw std::runtime_error("Failed to get property maxLineLength: must be larger than zero");
+    }
+
+    if (options.framing.maxRecordLength == 0)
+    {
+        throw std::runtime_error("Failed to get property maxRecordLength: must be larger than zero");
+    }
+}
+
+CaptureOptions::CaptureOptions(v8::Local<v8::Object> obj)
+    : readerOptions(SubscribeOptions(obj).options)
+{
+    if (Utility::Has(obj, "maxFileSize"))
+    {
+        options.maxFileSize = Convert::getNativeUint32(obj, "maxFileSize");
+    }
+
+    if (Utility::Has(obj, "maxFiles"))
+    {
+        options.maxFiles = Convert::getNativeUint32(obj, "maxFiles");
+    }
+
+    if (Utility::Has(obj, "timestamps"))
+    {
+        options.timestamps = Convert::getNativeBool(obj, "timestamps") != 0;
+    }
+
+    if (Utility::Has(obj, "statisticsInterval"))
+    {
+        options.statisticsInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "statisticsInterval"));
+    }
+
+    options.framing          = readerOptions.framing.mode;
+    options.lengthPrefixSize = readerOptions.framing.lengthPrefixSize;
+}
+
+WriteQueueOptions::WriteQueueOptions(v8::Local<v8::Object> obj)
+{
+    if (Utility::Has(obj, "highWaterMark"))
+    {
+        options.highWaterMark = Convert::getNativeUint32(obj, "highWaterMark");
+    }
+
+    if (Utility::Has(obj, "maxWriteLength"))
+    {
+        options.maxWriteLength = Convert::getNativeUint32(obj, "maxWriteLength");
+    }
+
+    if (Utility::Has(obj, "minRetryInterval"))
+    {
+        options.minRetryInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "minRetryInterval"));
+    }
+
+    if (Utility::Has(obj, "maxRetryInterval"))
+    {
+        options.maxRetryInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "maxRetryInterval"));
+    }
+
+    // The retry interval doubles while the target is full, so it can never start at zero
+    options.minRetryInterval = std::max(options.minRetryInterval, std::chrono::milliseconds(1));
+    options.maxRetryInterval = std::max(options.maxRetryInterval, options.minRetryInterval);
+
+    if (options.maxWriteLength == 0)
+    {
+        throw std::runtime_error("Failed to get property maxWriteLength: must be larger than zero");
+    }
+}
+
+WatcherOptions::WatcherOptions(v8::Local<v8::Object> obj)
+{
+    if (Utility::Has(obj, "pollInterval"))
+    {
+        options.pollInterval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "pollInterval"));
+    }
+
+    if (Utility::Has(obj, "debounceTime"))
+    {
+        options.debounceTime = std::chrono::milliseconds(Convert::getNativeUint32(obj, "debounceTime"));
+    }
+
+    if (Utility::Has(obj, "simulated"))
+    {
+        options.simulated = Convert::getNativeBool(obj, "simulated") != 0;
+    }
+
+    if (options.pollInterval.count() == 0)
+    {
+        throw std::runtime_error("Failed to get property pollInterval: must be larger than zero");
+    }
+}
+
+EnumerationOptions::EnumerationOptions()
+    : minSerialNumber(0)
+    , maxSerialNumber(UINT32_MAX)
+    , fields(ENUMERATE_ALL_INFO)
+{}
+
+EnumerationOptions::EnumerationOptions(v8::Local<v8::Object> obj)
+    : EnumerationOptions()
+{
+    if (Utility::Has(obj, "serialNumberPrefix"))
+    {
+        serialNumberPrefix = Convert::getNativeString(obj, "serialNumberPrefix");
+    }
+
+    if (Utility::Has(obj, "minSerialNumber"))
+    {
+        minSerialNumber = Convert::getNativeUint32(obj, "minSerialNumber");
+    }
+
+    if (Utility::Has(obj, "maxSerialNumber"))
+    {
+        maxSerialNumber = Convert::getNativeUint32(obj, "maxSerialNumber");
+    }
+
+    if (Utility::Has(obj, "fields"))
+    {
+        fields = static_cast<enumeration_fields_t>(Convert::getNativeUint32(obj, "fields"));
+    }
+
+    if (fields > ENUMERATE_ALL_INFO)
+    {
+        throw std::runtime_error("Failed to get property fields: must be one of the ENUMERATE_ constants");
+    }
+
+    if (serialNumberPrefix.find_first_not_of("0123456789") != std::string::npos)
+    {
+        throw std::runtime_error("Failed to get property serialNumberPrefix: must only contain decimal digits");
+    }
+}
+
+bool EnumerationOptions::matches(const uint32_t serialNumber) const
+{
+    if (serialNumber < minSerialNumber || serialNumber > maxSerialNumber)
+    {
+        return false;
+    }
+
+    return std::to_string(serialNumber).compare(0, serialNumberPrefix.size(), serialNumberPrefix) == 0;
+}
+
+std::vector<uint32_t> EnumerationOptions::apply(const std::vector<uint32_t> & serialNumbers) const
+{
+    std::vector<uint32_t> matching;
+
+    std::copy_if(serialNumbers.begin(),
+                 serialNumbers.end(),
+                 std::back_inserter(matching),
+                 [this](const uint32_t serialNumber) { return matches(serialNumber); });
+
+    return matching;
+}
+
+LogOptions::LogOptions()
+    : since(0)
+    , level(LOG_LEVEL_TRACE)
+    , serialNumber(0)
+{}
+
+LogOptions::LogOptions(v8::Local<v8::Object> obj)
+    : LogOptions()
+{
+    if (Utility::Has(obj, "since"))
+    {
+        since = static_cast<uint64_t>(std::max(Convert::getNativeDouble(obj, "since"), 0.0));
+    }
+
+    if (Utility::Has(obj, "level"))
+    {
+        const auto nativeLevel = Convert::getNativeUint32(obj, "level");
+
+        if (nativeLevel > LOG_LEVEL_NONE)
+        {
+            throw std::runtime_error("Failed to get property level: not a log level");
+        }
+
+        level = static_cast<log_level_t>(nativeLevel);
+    }
+
+    if (Utility::Has(obj, "serialNumber"))
+    {
+        serialNumber = Convert::getNativeUint32(obj, "serialNumber");
+    }
+}
+
+bool LogOptions::matches(const LogRing::Record & record) const
+{
+    return record.sequence >= since && record.level >= level &&
+           (serialNumber == 0 || record.serialNumber == serialNumber);
+}
+
+LogSubscriptionOptions::LogSubscriptionOptions(v8::Local<v8::Object> obj)
+{
+    const LogOptions filter(obj);
+    options.level        = filter.level;
+    options.serialNumber = filter.serialNumber;
+
+    if (Utility::Has(obj, "interval"))
+    {
+        options.interval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "interval"));
+    }
+
+    if (Utility::Has(obj, "maxRecordsPerSecond"))
+    {
+        options.maxRecordsPerSecond = Convert::getNativeUint32(obj, "maxRecordsPerSecond");
+    }
+
+    if (options.interval.count() == 0)
+    {
+        throw std::runtime_error("Failed to get property interval: must be larger than zero");
+    }
+
+    if (options.maxRecordsPerSecond == 0)
+    {
+        throw std::runtime_error("Failed to get property maxRecordsPerSecond: must be larger than zero");
+    }
+}
+
+TraceOptions::TraceOptions()
+    : capacity(OperationTrace::DEFAULT_CAPACITY)
+{}
+
+TraceOptions::TraceOptions(v8::Local<v8::Object> obj)
+    : TraceOptions()
+{
+    if (Utility::Has(obj, "capacity"))
+    {
+        capacity = Convert::getNativeUint32(obj, "capacity");
+    }
+
+    if (capacity == 0)
+    {
+        throw std::runtime_error("Failed to get property capacity: must be larger than zero");
+    }
+}
+
+HealthMonitorOptions::HealthMonitorOptions(v8::Local<v8::Object> obj)
+{
+    if (Utility::Has(obj, "interval"))
+    {
+        options.interval = std::chrono::milliseconds(Convert::getNativeUint32(obj, "interval"));
+    }
+
+    if (Utility::Has(obj, "failureThreshold"))
+    {
+        options.failureThreshold = Convert::getNativeUint32(obj, "failureThreshold");
+    }
+
+    if (Utility::Has(obj, "serialNumbers"))
+    {
+        options.serialNumbers = Convert::getVectorForUint32(obj, "serialNumbers");
+    }
+
+    if (options.interval.count() == 0)
+    {
+        throw std::runtime_error("Failed to get property interval: must be larger than zero");
+    }
+
+    if (options.failureThreshold == 0)
+    {
+        throw std::runtime_error("Failed to get property failureThreshold: must be larger than zero");
+    }
 }
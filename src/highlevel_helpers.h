@@ -40,25 +40,141 @@
 #include "highlevel_common.h"
 #include "highlevelnrfjprogdll.h"
 #include "nan_wrap.h"
+#include "library_call_statistics.h"
+#include "log_ring.h"
+#include "log_subscriber.h"
+#include "operation_timing.h"
+#include "operation_trace.h"
+#include "throughput_counters.h"
+#include "probe_enumeration.h"
+#include "probe_health.h"
+#include "probe_watcher.h"
+#include "rtt_reader.h"
+#include "rtt_writer.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
 
 class ProbeDetails
 {
   public:
-    ProbeDetails(uint32_t _serial_number, device_info_t _device_info, probe_info_t _probe_info,
-                 library_info_t _library_info)
-        : serial_number(_serial_number)
-        , device_info(_device_info)
-        , probe_info(_probe_info)
-        , library_info(_library_info)
+    ProbeDetails(const ProbeEnumerationResult & _result)
+        : serial_number(_result.serialNumber)
+        , fields(_result.fields)
+        , device_info(_result.deviceInfo)
+        , probe_info(_result.probeInfo)
+        , library_info(_result.libraryInfo)
+        , error(_result.error)
+        , failed_step(_result.failedStep != nullptr ? _result.failedStep : "")
+        , duration(_result.duration)
+        , cached(_result.cached)
     {}
 
     v8::Local<v8::Object> ToJs();
 
   private:
     const uint32_t serial_number;
+    const enumeration_fields_t fields;
     const device_info_t device_info;
     const probe_info_t probe_info;
     const library_info_t library_info;
+    const nrfjprogdll_err_t error;
+    const std::string failed_step;
+    const std::chrono::microseconds duration;
+    const bool cached;
+};
+
+class TimingInfo
+{
+  public:
+    TimingInfo(const BatonTiming & _timing)
+        : timing(_timing)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    const BatonTiming timing;
+};
+
+class OperationStatisticsInfo
+{
+  public:
+    OperationStatisticsInfo(const std::map<std::string, OperationStatistics::Entry> & _methods,
+                            const std::map<uint32_t, OperationStatistics::Entry> & _serialNumbers)
+        : methods(_methods)
+        , serialNumbers(_serialNumbers)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    static v8::Local<v8::Object> EntryToJs(const OperationStatistics::Entry & entry);
+
+    const std::map<std::string, OperationStatistics::Entry> methods;
+    const std::map<uint32_t, OperationStatistics::Entry> serialNumbers;
+};
+
+class LibraryCallStatisticsInfo
+{
+  public:
+    LibraryCallStatisticsInfo(const LibraryCallStatistics::function_map_t & _functions,
+                              const std::map<uint32_t, LibraryCallStatistics::function_map_t> & _serialNumbers)
+        : functions(_functions)
+        , serialNumbers(_serialNumbers)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    static v8::Local<v8::Object> FunctionsToJs(const LibraryCallStatistics::function_map_t & entries);
+    static v8::Local<v8::Object> EntryToJs(const LibraryCallStatistics::Entry & entry);
+
+    const LibraryCallStatistics::function_map_t functions;
+    const std::map<uint32_t, LibraryCallStatistics::function_map_t> serialNumbers;
+};
+
+class ThroughputInfo
+{
+  public:
+    ThroughputInfo(const std::map<uint32_t, ThroughputCounters::counters_t> & _serialNumbers)
+        : serialNumbers(_serialNumbers)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    static v8::Local<v8::Object> CounterToJs(const ThroughputCounters::Counter & counter);
+
+    const std::map<uint32_t, ThroughputCounters::counters_t> serialNumbers;
+};
+
+class LogRecordInfo
+{
+  public:
+    LogRecordInfo(const LogRing::Record & _record)
+        : record(_record)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    const LogRing::Record & record;
+};
+
+class ProbeHealthInfo
+{
+  public:
+    ProbeHealthInfo(const ProbeHealth & _health)
+        : health(_health)
+    {}
+
+    v8::Local<v8::Object> ToJs();
+
+  private:
+    const ProbeHealth health;
 };
 
 class ProbeInfo
@@ -148,6 +264,13 @@ class ChannelInfo
     const uint32_t size;
 };
 
+struct ControlBlockSearchOptions
+{
+    std::chrono::milliseconds initialInterval{10};
+    std::chrono::milliseconds maxInterval{200};
+    std::chrono::milliseconds timeout{5000};
+};
+
 class StartOptions
 {
   public:
@@ -155,6 +278,106 @@ class StartOptions
 
     uint32_t controlBlockLocation;
     bool hasControlBlockLocation;
+    ControlBlockSearchOptions searchOptions;
+    uint32_t bufferSize;
+
+    bool reset;
+    bool hasSearchRange;
+    uint32_t searchRangeStart;
+    uint32_t searchRangeLength;
+    std::string elfPath;
+
+    bool autoRecover;
+};
+
+class SubscribeOptions
+{
+  public:
+    SubscribeOptions(v8::Local<v8::Object> obj);
+
+    RttReaderOptions options;
+};
+
+class CaptureOptions
+{
+  public:
+    CaptureOptions(v8::Local<v8::Object> obj);
+
+    RttReaderOptions readerOptions;
+    RttCaptureOptions options;
+};
+
+class WriteQueueOptions
+{
+  public:
+    WriteQueueOptions(v8::Local<v8::Object> obj);
+
+    RttWriterOptions options;
+};
+
+class WatcherOptions
+{
+  public:
+    WatcherOptions(v8::Local<v8::Object> obj);
+
+    ProbeWatcherOptions options;
+};
+
+// Selects the probes to enumerate by a decimal prefix of the serial number and an
+// inclusive range, and the information that is read for each of them
+class EnumerationOptions
+{
+  public:
+    EnumerationOptions();
+    EnumerationOptions(v8::Local<v8::Object> obj);
+
+    bool matches(uint32_t serialNumber) const;
+    std::vector<uint32_t> apply(const std::vector<uint32_t> & serialNumbers) const;
+
+    std::string serialNumberPrefix;
+    uint32_t minSerialNumber;
+    uint32_t maxSerialNumber;
+
+    enumeration_fields_t fields;
+};
+
+class HealthMonitorOptions
+{
+  public:
+    HealthMonitorOptions(v8::Local<v8::Object> obj);
+
+    ProbeHealthOptions options;
+};
+
+// Selects the log records returned by a query
+class LogOptions
+{
+  public:
+    LogOptions();
+    LogOptions(v8::Local<v8::Object> obj);
+
+    bool matches(const LogRing::Record & record) const;
+
+    uint64_t since;
+    log_level_t level;
+    uint32_t serialNumber; // 0 for all probes
+};
+
+class LogSubscriptionOptions
+{
+  public:
+    LogSubscriptionOptions(v8::Local<v8::Object> obj);
+
+    LogSubscriberOptions options;
+};
+
+class TraceOptions
+{
+  public:
+    TraceOptions();
+    TraceOptions(v8::Local<v8::Object> obj);
+
+    size_t capacity;
 };
 
 class VerifyOptions
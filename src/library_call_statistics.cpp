@@ -0,0 +1,119 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "library_call_statistics.h"
+
+#include <algorithm>
+
+#include "operation_trace.h"
+
+std::mutex LibraryCallStatistics::mutex;
+LibraryCallStatistics::function_map_t LibraryCallStatistics::functions;
+std::map<uint32_t, LibraryCallStatistics::function_map_t> LibraryCallStatistics::serialNumbers;
+
+namespace
+{
+LibraryCallStatistics::Entry & entryOf(LibraryCallStatistics::function_map_t & entries, const char * function)
+{
+    auto entry = entries.find(function);
+
+    if (entry == entries.end())
+    {
+        entry = entries.emplace(function, LibraryCallStatistics::Entry{}).first;
+    }
+
+    return entry->second;
+}
+} // namespace
+
+void LibraryCallStatistics::Entry::add(const std::chrono::microseconds duration, const int32_t error)
+{
+    ++count;
+    total += duration;
+    max = std::max(max, duration);
+
+    if (error != 0)
+    {
+        ++errors;
+        ++errorCodes[error];
+    }
+
+    // The bucket is the number of bits needed for the duration
+    auto value    = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+    size_t bucket = 0;
+
+    while (value > 0 && bucket < HISTOGRAM_BUCKETS - 1)
+    {
+        value >>= 1;
+        ++bucket;
+    }
+
+    ++histogram[bucket];
+}
+
+void LibraryCallStatistics::record(const char * function, const std::chrono::microseconds duration,
+                                   const int32_t error)
+{
+    const auto serialNumber = OperationTrace::currentSerialNumber();
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    entryOf(functions, function).add(duration, error);
+
+    if (serialNumber != 0)
+    {
+        entryOf(serialNumbers[serialNumber], function).add(duration, error);
+    }
+}
+
+void LibraryCallStatistics::reset()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    functions.clear();
+    serialNumbers.clear();
+}
+
+LibraryCallStatistics::function_map_t LibraryCallStatistics::getFunctions()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return functions;
+}
+
+std::map<uint32_t, LibraryCallStatistics::function_map_t> LibraryCallStatistics::getSerialNumbers()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return serialNumbers;
+}
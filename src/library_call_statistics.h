@@ -0,0 +1,87 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBRARY_CALL_STATISTICS_H
+#define LIBRARY_CALL_STATISTICS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Counts, errors and latencies of the calls into the nrfjprog library, per function and per probe.
+// The probe is the lane of the thread making the call, see OperationTrace::TrackScope.
+class LibraryCallStatistics
+{
+  public:
+    static const size_t HISTOGRAM_BUCKETS = 25;
+
+    struct Entry
+    {
+        uint64_t count{0};
+        uint64_t errors{0};
+        std::chrono::microseconds total{0};
+        std::chrono::microseconds max{0};
+
+        // Bucket i counts the calls that took from 2^(i-1) up to 2^i microseconds,
+        // the last bucket also counts all calls that took longer
+        std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+
+        // Number of calls that failed, per error code
+        std::map<int32_t, uint64_t> errorCodes;
+
+        void add(std::chrono::microseconds duration, int32_t error);
+    };
+
+    // Looked up by the name of the function without creating a string
+    using function_map_t = std::map<std::string, Entry, std::less<>>;
+
+    static void record(const char * function, std::chrono::microseconds duration, int32_t error);
+    static void reset();
+
+    static function_map_t getFunctions();
+    static std::map<uint32_t, function_map_t> getSerialNumbers();
+
+  private:
+    static std::mutex mutex;
+    static function_map_t functions;
+    static std::map<uint32_t, function_map_t> serialNumbers;
+};
+
+#endif // LIBRARY_CALL_STATISTICS_H
@@ -0,0 +1,149 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "log_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "operation_trace.h"
+
+std::array<LogRing::Slot, LogRing::CAPACITY> LogRing::slots;
+std::atomic<uint64_t> LogRing::next{0};
+std::atomic<uint64_t> LogRing::dropped{0};
+std::atomic<log_level_t> LogRing::level{LOG_LEVEL_DEBUG};
+
+void LogRing::setLevel(const log_level_t _level)
+{
+    level = _level;
+}
+
+log_level_t LogRing::getLevel()
+{
+    return level;
+}
+
+void LogRing::add(const log_level_t recordLevel, const char * message)
+{
+    add(recordLevel, message, std::strlen(message));
+}
+
+void LogRing::add(const log_level_t recordLevel, const std::string & message)
+{
+    add(recordLevel, message.c_str(), message.size());
+}
+
+void LogRing::add(const log_level_t recordLevel, const char * message, size_t length)
+{
+    if (recordLevel < level.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Records are lines, the line breaks are added when they are joined
+    while (length > 0 && (message[length - 1] == '\n' || message[length - 1] == '\r'))
+    {
+        --length;
+    }
+
+    const auto sequence = next.fetch_add(1);
+    auto & slot         = slots[sequence % CAPACITY];
+
+    // Claim the slot, unless a writer that was lapped by the others is still writing it
+    auto state = slot.state.load(std::memory_order_relaxed);
+
+    if ((state & 1U) != 0 || !slot.state.compare_exchange_strong(state, state + 1, std::memory_order_acquire))
+    {
+        ++dropped;
+        return;
+    }
+
+    slot.sequence     = sequence;
+    slot.level        = recordLevel;
+    slot.serialNumber = OperationTrace::currentSerialNumber();
+    slot.timestamp    = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    slot.length = std::min(length, MESSAGE_SIZE);
+    std::memcpy(slot.message, message, slot.length);
+
+    slot.state.store(state + 2, std::memory_order_release);
+}
+
+uint64_t LogRing::nextSequence()
+{
+    return next.load();
+}
+
+uint64_t LogRing::getDropped()
+{
+    return dropped.load();
+}
+
+std::vector<LogRing::Record> LogRing::copy(const uint64_t since)
+{
+    std::vector<Record> records;
+
+    for (auto & slot : slots)
+    {
+        const auto before = slot.state.load(std::memory_order_acquire);
+
+        if (before == 0 || (before & 1U) != 0)
+        {
+            continue;
+        }
+
+        Record record{slot.sequence, slot.level, slot.serialNumber, slot.timestamp, std::string()};
+        const auto length = std::min(slot.length, MESSAGE_SIZE);
+        record.message.assign(slot.message, length);
+
+        // The record is only valid if no writer claimed the slot while it was copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.state.load(std::memory_order_relaxed) != before || record.sequence < since)
+        {
+            continue;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](const Record & a, const Record & b) { return a.sequence < b.sequence; });
+
+    return records;
+}
@@ -0,0 +1,100 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include "highlevel_common.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A fixed size ring of log records that any thread can add to without taking a lock. Records
+// are only copied out when an error or a query needs them. A record that would overwrite a slot
+// another thread is still writing is dropped, as are records below the log level.
+class LogRing
+{
+  public:
+    static const size_t CAPACITY     = 1024;
+    static const size_t MESSAGE_SIZE = 240; // Longer messages are truncated
+
+    struct Record
+    {
+        uint64_t sequence;
+        log_level_t level;
+        uint32_t serialNumber; // The probe lane the record was added on, 0 if none
+        int64_t timestamp;     // Microseconds since the epoch
+        std::string message;
+    };
+
+    static void setLevel(log_level_t level);
+    static log_level_t getLevel();
+
+    // Adds a record for the probe lane of this thread
+    static void add(log_level_t level, const char * message);
+    static void add(log_level_t level, const std::string & message);
+
+    // The sequence number of the next record
+    static uint64_t nextSequence();
+    static uint64_t getDropped();
+
+    // The records from the sequence number on that are still in the ring, oldest first
+    static std::vector<Record> copy(uint64_t since);
+
+  private:
+    struct Slot
+    {
+        std::atomic<uint32_t> state{0}; // 0 while empty, odd while being written
+        uint64_t sequence{0};
+        log_level_t level{LOG_LEVEL_TRACE};
+        uint32_t serialNumber{0};
+        int64_t timestamp{0};
+        size_t length{0};
+        char message[MESSAGE_SIZE];
+    };
+
+    static void add(log_level_t level, const char * message, size_t length);
+
+    static std::array<Slot, CAPACITY> slots;
+    static std::atomic<uint64_t> next;
+    static std::atomic<uint64_t> dropped;
+    static std::atomic<log_level_t> level;
+};
+
+#endif // LOG_RING_H
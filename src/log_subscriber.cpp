@@ -0,0 +1,211 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "log_subscriber.h"
+
+#include <algorithm>
+
+#include "highlevel_helpers.h"
+#include "utility/conversion.h"
+
+LogSubscriber::LogSubscriber(const LogSubscriberOptions & _options, v8::Local<v8::Function> _callback)
+    : options(_options)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , since(0)
+    , tokens(0)
+    , dropped(0)
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+LogSubscriber::~LogSubscriber()
+{
+    stop();
+
+    asyncHandle->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+             [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+}
+
+void LogSubscriber::start()
+{
+    since    = LogRing::nextSequence();
+    tokens   = options.maxRecordsPerSecond;
+    lastPoll = std::chrono::steady_clock::now();
+    running  = true;
+    thread   = std::thread(&LogSubscriber::run, this);
+}
+
+void LogSubscriber::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+
+    wakeCondition.notify_all();
+
+    if (thread.joinable())
+    {
+        thread.join();
+
+        // The records added until now are still passed on
+        poll();
+    }
+}
+
+void LogSubscriber::run()
+{
+    while (running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, options.interval, [this]() { return !running; });
+        }
+
+        poll();
+    }
+}
+
+void LogSubscriber::poll()
+{
+    const auto now     = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::duration<double>(now - lastPoll).count();
+    lastPoll           = now;
+
+    tokens = std::min(tokens + elapsed * options.maxRecordsPerSecond,
+                      static_cast<double>(options.maxRecordsPerSecond));
+
+    const auto records = LogRing::copy(since);
+
+    // A record that is still being written at the end of the ring is read on the next poll
+    const auto end = records.empty() ? since : records.back().sequence + 1;
+    auto lost      = (end - since) - records.size();
+    since          = end;
+
+    std::vector<LogRing::Record> selected;
+
+    for (const auto & record : records)
+    {
+        if (!matches(record))
+        {
+            continue;
+        }
+
+        if (tokens < 1)
+        {
+            ++lost;
+            continue;
+        }
+
+        tokens -= 1;
+        selected.push_back(record);
+    }
+
+    if (selected.empty() && lost == 0)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        pending.insert(pending.end(), selected.begin(), selected.end());
+        dropped += lost;
+
+        // JS is not keeping up, the oldest records go first
+        while (pending.size() > LogRing::CAPACITY)
+        {
+            pending.pop_front();
+            ++dropped;
+        }
+    }
+
+    uv_async_send(asyncHandle);
+}
+
+bool LogSubscriber::matches(const LogRing::Record & record) const
+{
+    return record.level >= options.level && (options.serialNumber == 0 || record.serialNumber == options.serialNumber);
+}
+
+void LogSubscriber::deliver()
+{
+    std::deque<LogRing::Record> records;
+    uint64_t droppedRecords;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        records.swap(pending);
+        droppedRecords = dropped;
+        dropped        = 0;
+    }
+
+    if (records.empty() && droppedRecords == 0)
+    {
+        return;
+    }
+
+    Nan::HandleScope scope;
+    Nan::AsyncResource resource("pc-nrfjprog-js:log-subscriber");
+
+    v8::Local<v8::Array> batch = Nan::New<v8::Array>();
+    int i                      = 0;
+    for (const auto & record : records)
+    {
+        Nan::Set(batch, Convert::toJsNumber(i), LogRecordInfo(record).ToJs());
+        i++;
+    }
+
+    v8::Local<v8::Value> argv[3];
+    argv[0] = Nan::Undefined();
+    argv[1] = batch;
+    argv[2] = Convert::toJsNumber(static_cast<double>(droppedRecords));
+
+    callback->Call(3, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+}
+
+void LogSubscriber::onAsync(uv_async_t * handle)
+{
+    auto subscriber = static_cast<LogSubscriber *>(handle->data);
+
+    if (subscriber != nullptr)
+    {
+        subscriber->deliver();
+    }
+}
@@ -0,0 +1,110 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LOG_SUBSCRIBER_H
+#define LOG_SUBSCRIBER_H
+
+#include "highlevel_common.h"
+#include "log_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct LogSubscriberOptions
+{
+    log_level_t level{LOG_LEVEL_TRACE};
+    uint32_t serialNumber{0}; // 0 for all probes
+
+    // How often the ring is read, the records found are passed to JS as one batch
+    std::chrono::milliseconds interval{100};
+
+    // Records above this rate are dropped and counted, short bursts of up to a second are let through
+    uint32_t maxRecordsPerSecond{1000};
+};
+
+// Passes the records added to the log ring to a JS callback in batches, through uv_async.
+// A background thread reads the ring every interval, so adding a record costs the threads
+// that log nothing more than before. Records that were overwritten in the ring before they
+// were read, that exceed the rate limit or that JS has not taken yet when the pending
+// batch is full are dropped, and their number is passed along with the next batch.
+//
+// The subscriber is created and destroyed on the JS thread.
+class LogSubscriber
+{
+  public:
+    LogSubscriber(const LogSubscriberOptions & options, v8::Local<v8::Function> callback);
+    ~LogSubscriber();
+
+    // Records from the next sequence number on are delivered
+    void start();
+    void stop();
+
+    // Passes the pending records to the JS callback, call it before the subscriber is deleted
+    void deliver();
+
+  private:
+    void run();
+    void poll();
+    bool matches(const LogRing::Record & record) const;
+
+    static void onAsync(uv_async_t * handle);
+
+    const LogSubscriberOptions options;
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    // Only accessed by the background thread
+    uint64_t since;
+    double tokens;
+    std::chrono::steady_clock::time_point lastPoll;
+
+    std::mutex pendingMutex;
+    std::deque<LogRing::Record> pending;
+    uint64_t dropped;
+};
+
+#endif // LOG_SUBSCRIBER_H
@@ -0,0 +1,122 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "operation_timing.h"
+
+#include <algorithm>
+
+void BatonTiming::queue()
+{
+    queued = std::chrono::steady_clock::now();
+
+    if (executions == 0)
+    {
+        created = queued;
+    }
+}
+
+void BatonTiming::startPhase()
+{
+    phaseStart = std::chrono::steady_clock::now();
+}
+
+void BatonTiming::endPhase(std::chrono::microseconds & phase)
+{
+    const auto now = std::chrono::steady_clock::now();
+    phase += std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart);
+    phaseStart = now;
+}
+
+void BatonTiming::finish()
+{
+    total = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - created);
+}
+
+void OperationStatistics::Phase::add(const std::chrono::microseconds duration)
+{
+    sum += duration;
+    max = std::max(max, duration);
+}
+
+void OperationStatistics::Entry::add(const BatonTiming & timing, const bool failed)
+{
+    ++count;
+
+    if (failed)
+    {
+        ++errors;
+    }
+
+    queueWait.add(timing.queueWait);
+    lockWait.add(timing.lockWait);
+    probeInit.add(timing.probeInit);
+    operation.add(timing.operation);
+    cleanup.add(timing.cleanup);
+    returnConversion.add(timing.returnConversion);
+    total.add(timing.total);
+}
+
+void OperationStatistics::record(const std::string & name, const uint32_t serialNumber, const BatonTiming & timing,
+                                 const bool failed)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    methods[name].add(timing, failed);
+
+    if (serialNumber != 0)
+    {
+        serialNumbers[serialNumber].add(timing, failed);
+    }
+}
+
+void OperationStatistics::reset()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    methods.clear();
+    serialNumbers.clear();
+}
+
+std::map<std::string, OperationStatistics::Entry> OperationStatistics::getMethods()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return methods;
+}
+
+std::map<uint32_t, OperationStatistics::Entry> OperationStatistics::getSerialNumbers()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return serialNumbers;
+}
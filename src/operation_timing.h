@@ -0,0 +1,112 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OPERATION_TIMING_H
+#define OPERATION_TIMING_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// The time a baton spent in each phase, added up over all of its executions
+// when the function is rescheduled. The reschedule delays are not counted.
+struct BatonTiming
+{
+    std::chrono::steady_clock::time_point created; // When the function was first queued
+    std::chrono::steady_clock::time_point queued;  // When the function was last queued
+
+    std::chrono::microseconds queueWait{0};        // For a thread of the libuv thread pool
+    std::chrono::microseconds lockWait{0};         // For the execution mutex or the session lane
+    std::chrono::microseconds probeInit{0};
+    std::chrono::microseconds operation{0};
+    std::chrono::microseconds cleanup{0};          // Reset and probe uninit after the operation
+    std::chrono::microseconds returnConversion{0}; // Of the results and the error into JS values
+    std::chrono::microseconds total{0};            // From first queued until the callback is called
+
+    uint32_t executions{0};
+
+    void queue();
+    void startPhase();
+    void endPhase(std::chrono::microseconds & phase);
+    void finish();
+
+  private:
+    std::chrono::steady_clock::time_point phaseStart;
+};
+
+// The timings of all functions that returned, per function and per serial number
+class OperationStatistics
+{
+  public:
+    struct Phase
+    {
+        std::chrono::microseconds sum{0};
+        std::chrono::microseconds max{0};
+
+        void add(std::chrono::microseconds duration);
+    };
+
+    struct Entry
+    {
+        uint64_t count{0};
+        uint64_t errors{0};
+
+        Phase queueWait;
+        Phase lockWait;
+        Phase probeInit;
+        Phase operation;
+        Phase cleanup;
+        Phase returnConversion;
+        Phase total;
+
+        void add(const BatonTiming & timing, bool failed);
+    };
+
+    void record(const std::string & name, uint32_t serialNumber, const BatonTiming & timing, bool failed);
+    void reset();
+
+    std::map<std::string, Entry> getMethods();
+    std::map<uint32_t, Entry> getSerialNumbers();
+
+  private:
+    std::mutex mutex;
+    std::map<std::string, Entry> methods;
+    std::map<uint32_t, Entry> serialNumbers;
+};
+
+#endif // OPERATION_TIMING_H
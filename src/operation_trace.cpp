@@ -0,0 +1,299 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "operation_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+std::atomic<bool> OperationTrace::started{false};
+std::atomic<uint64_t> OperationTrace::ids{0};
+std::mutex OperationTrace::mutex;
+std::vector<OperationTrace::Event> OperationTrace::events;
+size_t OperationTrace::next{0};
+size_t OperationTrace::count{0};
+OperationTrace::clock::time_point OperationTrace::origin;
+
+namespace
+{
+thread_local uint32_t threadTrack = OperationTrace::LIBRARY_TRACK;
+
+std::string escape(const std::string & text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+
+    for (const auto c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) >= 0x20)
+        {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+std::string trackName(const uint32_t track)
+{
+    if (track == OperationTrace::JS_TRACK)
+    {
+        return "JS thread";
+    }
+
+    if (track == OperationTrace::LIBRARY_TRACK)
+    {
+        return "No probe";
+    }
+
+    return "Probe " + std::to_string(track);
+}
+} // namespace
+
+uint32_t OperationTrace::laneTrack(const uint32_t serialNumber)
+{
+    return serialNumber == 0 ? LIBRARY_TRACK : serialNumber;
+}
+
+OperationTrace::TrackScope::TrackScope(const uint32_t track)
+    : previous(threadTrack)
+{
+    threadTrack = track;
+}
+
+OperationTrace::TrackScope::~TrackScope()
+{
+    threadTrack = previous;
+}
+
+OperationTrace::Span::Span(const char * prefix, const std::string & _name, const char * _category,
+                           const uint32_t _track)
+    : category(_category)
+    , track(_track)
+{
+    // The name is only put together when the trace is started, to keep the cost low otherwise
+    if (isStarted())
+    {
+        active = true;
+        name   = std::string(prefix) + _name;
+        start  = clock::now();
+    }
+}
+
+OperationTrace::Span::~Span()
+{
+    if (active)
+    {
+        const auto end = clock::now();
+        record(Event{std::move(name), category, 'X', track, 0, start, between(start, end), false, 0});
+    }
+}
+
+void OperationTrace::start(const size_t capacity)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    events.clear();
+    events.resize(std::max<size_t>(capacity, 1));
+    next   = 0;
+    count  = 0;
+    origin = clock::now();
+
+    started = true;
+}
+
+void OperationTrace::stop()
+{
+    started = false;
+}
+
+bool OperationTrace::isStarted()
+{
+    return started.load(std::memory_order_relaxed);
+}
+
+uint32_t OperationTrace::currentTrack()
+{
+    return threadTrack;
+}
+
+uint32_t OperationTrace::currentSerialNumber()
+{
+    return threadTrack == JS_TRACK || threadTrack == LIBRARY_TRACK ? 0 : threadTrack;
+}
+
+uint64_t OperationTrace::nextId()
+{
+    return ++ids;
+}
+
+void OperationTrace::complete(const char * prefix, const std::string & name, const char * category,
+                              const uint32_t track, const clock::time_point start, const clock::time_point end)
+{
+    if (!isStarted())
+    {
+        return;
+    }
+
+    record(Event{prefix + name, category, 'X', track, 0, start, between(start, end), false, 0});
+}
+
+void OperationTrace::dllCall(const char * name, const clock::time_point start, const clock::time_point end,
+                             const int32_t error)
+{
+    if (!isStarted())
+    {
+        return;
+    }
+
+    record(Event{name, "dll", 'X', threadTrack, 0, start, between(start, end), true, error});
+}
+
+void OperationTrace::wait(const char * prefix, const std::string & name, const uint64_t id, const uint32_t track,
+                          const clock::time_point start, const clock::time_point end)
+{
+    if (!isStarted())
+    {
+        return;
+    }
+
+    const auto fullName = prefix + name;
+
+    record(Event{fullName, "wait", 'b', track, id, start, 0, false, 0});
+    record(Event{fullName, "wait", 'e', track, id, end, 0, false, 0});
+}
+
+bool OperationTrace::flush(const std::string & path, size_t & eventCount)
+{
+    std::vector<Event> flushed;
+    clock::time_point flushedOrigin;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Oldest first, the ring may have wrapped around
+        const auto capacity = events.size();
+        flushed.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            flushed.push_back(std::move(events[(next + capacity - count + i) % capacity]));
+        }
+
+        count         = 0;
+        flushedOrigin = origin;
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::set<uint32_t> tracks;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    auto first = true;
+
+    for (const auto & event : flushed)
+    {
+        tracks.insert(event.track);
+
+        file << (first ? "\n" : ",\n");
+        file << "{\"name\":\"" << escape(event.name) << "\",\"cat\":\"" << event.category << "\",\"ph\":\""
+             << event.phase << "\",\"pid\":1,\"tid\":" << event.track
+             << ",\"ts\":" << between(flushedOrigin, event.time);
+
+        if (event.phase == 'X')
+        {
+            file << ",\"dur\":" << event.duration;
+        }
+        else
+        {
+            file << ",\"id\":" << event.id;
+        }
+
+        if (event.hasError)
+        {
+            file << ",\"args\":{\"error\":" << event.error << "}";
+        }
+
+        file << "}";
+        first = false;
+    }
+
+    for (const auto track : tracks)
+    {
+        file << (first ? "\n" : ",\n");
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track << ",\"args\":{\"name\":\""
+             << trackName(track) << "\"}}";
+        first = false;
+    }
+
+    file << "\n]}\n";
+    file.close();
+
+    eventCount = flushed.size();
+
+    return !file.fail();
+}
+
+void OperationTrace::record(Event && event)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (!started || events.empty())
+    {
+        return;
+    }
+
+    events[next] = std::move(event);
+    next         = (next + 1) % events.size();
+    count        = std::min(count + 1, events.size());
+}
+
+int64_t OperationTrace::between(const clock::time_point start, const clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
@@ -0,0 +1,141 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OPERATION_TRACE_H
+#define OPERATION_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Records what the functions do as Chrome trace events, which can be loaded in chrome://tracing
+// or Perfetto. Each probe lane is a track, functions without a probe share one, and the JS thread
+// has its own. Events are kept in a ring until they are flushed to a file, the oldest are dropped.
+class OperationTrace
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    static const uint32_t JS_TRACK      = 0;
+    static const uint32_t LIBRARY_TRACK = 1;
+
+    static const size_t DEFAULT_CAPACITY = 65536;
+
+    // The track of the functions on a probe, serial number 0 is no probe
+    static uint32_t laneTrack(uint32_t serialNumber);
+
+    // Sets the track of the events recorded on this thread while in scope
+    class TrackScope
+    {
+      public:
+        explicit TrackScope(uint32_t track);
+        ~TrackScope();
+
+        TrackScope(const TrackScope &) = delete;
+        TrackScope & operator=(const TrackScope &) = delete;
+
+      private:
+        uint32_t previous;
+    };
+
+    // Records a complete event from construction until destruction, if the trace is started
+    class Span
+    {
+      public:
+        Span(const char * prefix, const std::string & name, const char * category, uint32_t track);
+        ~Span();
+
+        Span(const Span &) = delete;
+        Span & operator=(const Span &) = delete;
+
+      private:
+        bool active{false};
+        std::string name;
+        const char * category;
+        uint32_t track;
+        clock::time_point start;
+    };
+
+    static void start(size_t capacity);
+    static void stop();
+    static bool isStarted();
+
+    static uint32_t currentTrack();
+    // The serial number of the probe lane of this thread, 0 when it is not on one
+    static uint32_t currentSerialNumber();
+    static uint64_t nextId();
+
+    // These do nothing when the trace is not started, the name is the prefix followed by the name
+    static void complete(const char * prefix, const std::string & name, const char * category, uint32_t track,
+                         clock::time_point start, clock::time_point end);
+    static void dllCall(const char * name, clock::time_point start, clock::time_point end, int32_t error);
+    // Recorded as an async span, since the waits of functions on the same lane overlap each other
+    static void wait(const char * prefix, const std::string & name, uint64_t id, uint32_t track,
+                     clock::time_point start, clock::time_point end);
+
+    // Writes the events in the ring to a JSON file and empties the ring
+    static bool flush(const std::string & path, size_t & eventCount);
+
+  private:
+    struct Event
+    {
+        std::string name;
+        const char * category;
+        char phase;
+        uint32_t track;
+        uint64_t id;
+        clock::time_point time;
+        int64_t duration;
+        bool hasError;
+        int32_t error;
+    };
+
+    static void record(Event && event);
+    static int64_t between(clock::time_point start, clock::time_point end);
+
+    static std::atomic<bool> started;
+    static std::atomic<uint64_t> ids;
+    static std::mutex mutex;
+    static std::vector<Event> events;
+    static size_t next;
+    static size_t count;
+    static clock::time_point origin;
+};
+
+#endif // OPERATION_TRACE_H
@@ -38,12 +38,40 @@
 
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 void OSFilesInit(v8::Local<v8::Object> target)
 {
     Nan::SetMethod(target, "setLibrarySearchPath", OSFilesSetLibrarySearchPath);
 }
 
+uint64_t hexFileDataSize(const std::string & path)
+{
+    std::ifstream file(path);
+    std::string line;
+    uint64_t size = 0;
+
+    // Each record is :LLAAAATT<data>CC, only data records (type 00) are counted
+    while (std::getline(file, line))
+    {
+        if (line.size() < 9 || line[0] != ':' || line.compare(7, 2, "00") != 0)
+        {
+            continue;
+        }
+
+        try
+        {
+            size += std::stoul(line.substr(1, 2), nullptr, 16);
+        }
+        catch (const std::exception &)
+        {
+            return 0;
+        }
+    }
+
+    return size;
+}
+
 FileFormatHandler::FileFormatHandler(const std::string & fileinfo, input_format_t inputFormat)
 {
     if (inputFormat == INPUT_FORMAT_HEX_STRING)
@@ -96,6 +96,9 @@ class TempFile : public AbstractFile
     enum TempFileErrorcode { TempNoError, TempPathNotFound, TempCouldNotCreateFile } error;
 };
 
+// The number of data bytes in an Intel HEX file, 0 if it can not be read
+uint64_t hexFileDataSize(const std::string &path);
+
 class FileFormatHandler
 {
   public:
@@ -0,0 +1,183 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../../hotplug.h"
+
+#include <cstring>
+#include <string>
+
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Kernel uevents are received on a netlink socket, like udev does, without
+// depending on libudev. An eventfd interrupts the wait.
+struct HotplugMonitorPlatform
+{
+    int ueventSocket{-1};
+    int interruptEvent{-1};
+};
+
+namespace
+{
+// A uevent is "action@devpath" followed by NUL separated KEY=VALUE pairs
+bool isUsbDeviceChange(const char * message, const size_t length)
+{
+    auto isUsb    = false;
+    auto isChange = false;
+
+    size_t offset = 0;
+    while (offset < length)
+    {
+        const std::string field(message + offset, strnlen(message + offset, length - offset));
+        offset += field.size() + 1;
+
+        if (field == "SUBSYSTEM=usb")
+        {
+            isUsb = true;
+        }
+        else if (field == "ACTION=add" || field == "ACTION=remove")
+        {
+            isChange = true;
+        }
+    }
+
+    return isUsb && isChange;
+}
+} // namespace
+
+HotplugMonitor::HotplugMonitor()
+    : platform(std::make_unique<HotplugMonitorPlatform>())
+{
+    platform->interruptEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    const auto ueventSocket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (ueventSocket < 0)
+    {
+        return;
+    }
+
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_pid    = 0;
+    address.nl_groups = 1; // Kernel events
+
+    if (bind(ueventSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(ueventSocket);
+        return;
+    }
+
+    platform->ueventSocket = ueventSocket;
+}
+
+HotplugMonitor::~HotplugMonitor()
+{
+    if (platform->ueventSocket >= 0)
+    {
+        close(platform->ueventSocket);
+    }
+
+    if (platform->interruptEvent >= 0)
+    {
+        close(platform->interruptEvent);
+    }
+}
+
+bool HotplugMonitor::isAvailable() const
+{
+    return platform->ueventSocket >= 0 && platform->interruptEvent >= 0;
+}
+
+bool HotplugMonitor::wait(const std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    pollfd descriptors[2] = {{platform->interruptEvent, POLLIN, 0}, {platform->ueventSocket, POLLIN, 0}};
+    const nfds_t descriptorCount = isAvailable() ? 2 : 1;
+
+    for (;;)
+    {
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+        if (remaining.count() <= 0)
+        {
+            return false;
+        }
+
+        descriptors[0].revents = 0;
+        descriptors[1].revents = 0;
+
+        if (poll(static_cast<pollfd *>(descriptors), descriptorCount, static_cast<int>(remaining.count())) <= 0)
+        {
+            continue;
+        }
+
+        if ((descriptors[0].revents & POLLIN) != 0)
+        {
+            uint64_t count;
+            (void)read(platform->interruptEvent, &count, sizeof(count));
+            return false;
+        }
+
+        // Drain all queued messages, one add or remove is enough to list the probes again
+        auto changed = false;
+        char message[4096];
+        ssize_t length;
+
+        while ((length = recv(platform->ueventSocket, static_cast<char *>(message), sizeof(message), 0)) > 0)
+        {
+            changed = changed || isUsbDeviceChange(static_cast<char *>(message), static_cast<size_t>(length));
+        }
+
+        if (changed)
+        {
+            return true;
+        }
+    }
+}
+
+void HotplugMonitor::interrupt()
+{
+    if (platform->interruptEvent >= 0)
+    {
+        const uint64_t count = 1;
+        (void)write(platform->interruptEvent, &count, sizeof(count));
+    }
+}
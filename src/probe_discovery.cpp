@@ -0,0 +1,96 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "probe_discovery.h"
+
+#include "highlevel_helpers.h"
+
+ProbeDiscovery::ProbeDiscovery(v8::Local<v8::Function> _callback)
+    : callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+ProbeDiscovery::~ProbeDiscovery()
+{
+    asyncHandle->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+             [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+}
+
+void ProbeDiscovery::push(const ProbeEnumerationResult & result)
+{
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        pending.push_back(result);
+    }
+
+    uv_async_send(asyncHandle);
+}
+
+void ProbeDiscovery::deliver()
+{
+    std::vector<ProbeEnumerationResult> results;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        results.swap(pending);
+    }
+
+    Nan::HandleScope scope;
+    Nan::AsyncResource resource("pc-nrfjprog-js:discovery");
+
+    for (const auto & result : results)
+    {
+        v8::Local<v8::Value> argv[2];
+        argv[0] = Nan::Undefined();
+        argv[1] = ProbeDetails(result).ToJs();
+
+        callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+    }
+}
+
+void ProbeDiscovery::onAsync(uv_async_t * handle)
+{
+    auto discovery = static_cast<ProbeDiscovery *>(handle->data);
+
+    if (discovery != nullptr)
+    {
+        discovery->deliver();
+    }
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROBE_DISCOVERY_H
+#define PROBE_DISCOVERY_H
+
+#include "highlevel_common.h"
+#include "probe_enumeration.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Passes the details of each probe to a JS callback as soon as they are read.
+// Results are pushed from the enumeration threads and delivered on the JS
+// thread through uv_async, several at a time if they arrive in quick succession.
+//
+// The discovery is created and destroyed on the JS thread. Call deliver() before
+// reporting completion, so no result arrives after the completion callback.
+class ProbeDiscovery
+{
+  public:
+    explicit ProbeDiscovery(v8::Local<v8::Function> callback);
+    ~ProbeDiscovery();
+
+    void push(const ProbeEnumerationResult & result);
+    void deliver();
+
+  private:
+    static void onAsync(uv_async_t * handle);
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::mutex pendingMutex;
+    std::vector<ProbeEnumerationResult> pending;
+};
+
+#endif // PROBE_DISCOVERY_H
@@ -0,0 +1,228 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "probe_enumeration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "dll_call.h"
+
+// Upper bound on the serial number buffer, in case the library keeps filling any buffer it is given
+constexpr uint32_t MAX_CONNECTED_PROBES = 65536;
+
+namespace
+{
+// The library information of the first probe that could be read, for all other probes
+struct SharedLibraryInfo
+{
+    std::mutex mutex;
+    bool isRead{false};
+    library_info_t libraryInfo;
+};
+
+nrfjprogdll_err_t readLibraryInfo(Probe_handle_t probe, SharedLibraryInfo & shared, library_info_t & libraryInfo)
+{
+    std::unique_lock<std::mutex> lock(shared.mutex);
+
+    if (!shared.isRead)
+    {
+        const auto status = DLL_CALL(NRFJPROG_get_library_info, probe, &shared.libraryInfo);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+
+        shared.isRead = true;
+    }
+
+    libraryInfo = shared.libraryInfo;
+    return SUCCESS;
+}
+
+void readProbeDetails(ProbeEnumerationResult & result, SharedLibraryInfo & sharedLibraryInfo,
+                      progress_callback * progress, msg_callback * log, const probe_lane_lock_function_t & lockLane)
+{
+    const auto start = std::chrono::steady_clock::now();
+    OperationTrace::TrackScope trackScope(OperationTrace::laneTrack(result.serialNumber));
+
+    std::unique_lock<std::timed_mutex> laneLock;
+
+    if (!lockLane(result.serialNumber, laneLock))
+    {
+        result.error      = INVALID_OPERATION;
+        result.failedStep = "lock rtt lane";
+        result.duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        return;
+    }
+
+    Probe_handle_t probe;
+    result.error      = DLL_CALL(NRFJPROG_probe_init, &probe, progress, log, result.serialNumber, nullptr);
+    result.failedStep = result.error != SUCCESS ? "probe init" : nullptr;
+
+    if (result.error == SUCCESS)
+    {
+        // Only the device information needs a connection to the target
+        const auto deviceStatus = result.fields == ENUMERATE_ALL_INFO
+                                      ? DLL_CALL(NRFJPROG_get_device_info, probe, &result.deviceInfo)
+                                      : SUCCESS;
+        const auto probeStatus   = DLL_CALL(NRFJPROG_get_probe_info, probe, &result.probeInfo);
+        const auto libraryStatus = readLibraryInfo(probe, sharedLibraryInfo, result.libraryInfo);
+
+        // The details that could be read are still returned, the error tells which are missing
+        if (deviceStatus != SUCCESS)
+        {
+            result.error      = deviceStatus;
+            result.failedStep = "get device info";
+        }
+        else if (probeStatus != SUCCESS)
+        {
+            result.error      = probeStatus;
+            result.failedStep = "get probe info";
+        }
+        else if (libraryStatus != SUCCESS)
+        {
+            result.error      = libraryStatus;
+            result.failedStep = "get library info";
+        }
+
+        DLL_CALL(NRFJPROG_probe_uninit, &probe);
+    }
+
+    result.duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+} // namespace
+
+std::vector<ProbeEnumerationResult>
+enumerateProbes(const std::vector<uint32_t> & serialNumbers, const enumeration_fields_t fields,
+                const uint32_t maxConcurrency, progress_callback * progress, msg_callback * log,
+                const probe_lane_lock_function_t & lockLane,
+                const std::function<void(const ProbeEnumerationResult &)> & onResult)
+{
+    std::vector<ProbeEnumerationResult> results(serialNumbers.size(), ProbeEnumerationResult{});
+
+    for (size_t i = 0; i < serialNumbers.size(); ++i)
+    {
+        results[i].serialNumber = serialNumbers[i];
+        results[i].fields       = fields;
+    }
+
+    // The serial numbers are already known, none of the probes has to be opened
+    if (fields == ENUMERATE_SERIAL_NUMBERS)
+    {
+        for (const auto & result : results)
+        {
+            if (onResult)
+            {
+                onResult(result);
+            }
+        }
+
+        return results;
+    }
+
+    SharedLibraryInfo sharedLibraryInfo;
+
+    // Every worker takes the next probe that is not taken yet, until all are done
+    std::atomic<size_t> next(0);
+
+    const auto worker = [&]() {
+        for (auto i = next++; i < results.size(); i = next++)
+        {
+            readProbeDetails(results[i], sharedLibraryInfo, progress, log, lockLane);
+
+            if (onResult)
+            {
+                onResult(results[i]);
+            }
+        }
+    };
+
+    const auto workerCount = std::min(results.size(), static_cast<size_t>(std::max(maxConcurrency, 1U)));
+
+    if (workerCount <= 1)
+    {
+        worker();
+        return results;
+    }
+
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto & thread : workers)
+    {
+        thread.join();
+    }
+
+    return results;
+}
+
+nrfjprogdll_err_t listConnectedProbes(std::vector<uint32_t> & serialNumbers, const uint32_t initialCapacity)
+{
+    auto capacity = std::max(initialCapacity, 1U);
+
+    for (;;)
+    {
+        serialNumbers.resize(capacity);
+
+        uint32_t available = 0;
+        const auto status  = DLL_CALL(NRFJPROG_get_connected_probes, serialNumbers.data(), capacity, &available);
+
+        if (status != SUCCESS)
+        {
+            serialNumbers.clear();
+            return status;
+        }
+
+        // A full buffer may have been truncated, so list again with room to spare
+        if (available < capacity || capacity >= MAX_CONNECTED_PROBES)
+        {
+            serialNumbers.resize(std::min(available, capacity));
+            return SUCCESS;
+        }
+
+        capacity = std::min(std::max(capacity * 2, available + 1), MAX_CONNECTED_PROBES);
+    }
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROBE_ENUMERATION_H
+#define PROBE_ENUMERATION_H
+
+#include "highlevel_common.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+struct ProbeEnumerationResult
+{
+    uint32_t serialNumber;
+    enumeration_fields_t fields; // The information that was asked for, the rest is not set
+    device_info_t deviceInfo;
+    probe_info_t probeInfo;
+    library_info_t libraryInfo;
+
+    nrfjprogdll_err_t error;  // The first error while reading the details of the probe
+    const char * failedStep;  // The function that returned the error, nullptr on success
+    std::chrono::microseconds duration;
+    bool cached; // Taken from the device info cache instead of the probe
+};
+
+// Locks the lane of a probe whose RTT session runs outside the execution mutex, so the probe is
+// not opened a second time while the session uses it. Leaves the lock empty if the probe has no
+// lane, and returns false if the lane could not be locked.
+typedef std::function<bool(uint32_t, std::unique_lock<std::timed_mutex> &)> probe_lane_lock_function_t;
+
+// Lists the serial numbers of all connected probes. The buffer starts at
+// initialCapacity and is grown until the library reports fewer probes than fit.
+nrfjprogdll_err_t listConnectedProbes(std::vector<uint32_t> & serialNumbers, uint32_t initialCapacity);
+
+// Reads the selected information of every probe, with up to maxConcurrency
+// probes at the same time. Each probe is initialized on its own thread, so the
+// total time is close to that of the slowest probe. The library information is
+// the same for all probes, so it is only read from the first one. Returns when
+// all probes are done, with the results in the order of the serial numbers.
+// Each probe is read while holding its lane, if it has one.
+// If set, onResult is called from the worker thread as soon as a probe is done.
+std::vector<ProbeEnumerationResult>
+enumerateProbes(const std::vector<uint32_t> & serialNumbers, enumeration_fields_t fields, uint32_t maxConcurrency,
+                progress_callback * progress, msg_callback * log, const probe_lane_lock_function_t & lockLane,
+                const std::function<void(const ProbeEnumerationResult &)> & onResult = nullptr);
+
+#endif // PROBE_ENUMERATION_H
@@ -0,0 +1,264 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "probe_health.h"
+
+#include <algorithm>
+#include <set>
+
+#include "highlevel_helpers.h"
+
+constexpr size_t MAX_PARALLEL_CHECKS = 32;
+
+ProbeHealthMonitor::ProbeHealthMonitor(const ProbeHealthOptions & _options, v8::Local<v8::Function> _callback)
+    : options(_options)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+ProbeHealthMonitor::~ProbeHealthMonitor()
+{
+    stop();
+
+    asyncHandle->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+             [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+}
+
+void ProbeHealthMonitor::start(probe_list_open_function_t _listOpenProbes, probe_check_function_t _check)
+{
+    listOpenProbes = std::move(_listOpenProbes);
+    check          = std::move(_check);
+    running        = true;
+    thread         = std::thread(&ProbeHealthMonitor::run, this);
+}
+
+void ProbeHealthMonitor::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+
+    wakeCondition.notify_all();
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+std::vector<ProbeHealth> ProbeHealthMonitor::getSnapshot()
+{
+    std::unique_lock<std::mutex> lock(healthMutex);
+    std::vector<ProbeHealth> snapshot;
+
+    for (const auto & entry : health)
+    {
+        snapshot.push_back(entry.second);
+    }
+
+    return snapshot;
+}
+
+void ProbeHealthMonitor::run()
+{
+    while (running)
+    {
+        const auto roundStart = std::chrono::steady_clock::now();
+
+        // Each check only locks the lane of its own probe
+        checkAll(getMonitoredProbes());
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_until(lock, roundStart + options.interval, [this]() { return !running; });
+    }
+}
+
+std::vector<uint32_t> ProbeHealthMonitor::getMonitoredProbes()
+{
+    std::set<uint32_t> serialNumbers(options.serialNumbers.begin(), options.serialNumbers.end());
+
+    for (const auto serialNumber : listOpenProbes())
+    {
+        serialNumbers.insert(serialNumber);
+    }
+
+    // Probes that were closed are no longer reported
+    std::unique_lock<std::mutex> lock(healthMutex);
+
+    for (auto entry = health.begin(); entry != health.end();)
+    {
+        if (serialNumbers.count(entry->first) == 0)
+        {
+            entry = health.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+
+    return std::vector<uint32_t>(serialNumbers.begin(), serialNumbers.end());
+}
+
+void ProbeHealthMonitor::checkAll(const std::vector<uint32_t> & serialNumbers)
+{
+    std::vector<nrfjprogdll_err_t> results(serialNumbers.size(), SUCCESS);
+    std::vector<std::chrono::microseconds> latencies(serialNumbers.size(), std::chrono::microseconds(0));
+
+    // A dead probe can take long to time out, so it must not hold up the checks of the others
+    std::atomic<size_t> next(0);
+
+    const auto worker = [&]() {
+        for (auto i = next++; i < serialNumbers.size(); i = next++)
+        {
+            results[i] = check(serialNumbers[i], latencies[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const auto workerCount = std::min(serialNumbers.size(), MAX_PARALLEL_CHECKS);
+
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto & workerThread : workers)
+    {
+        workerThread.join();
+    }
+
+    std::vector<ProbeHealth> events;
+
+    {
+        std::unique_lock<std::mutex> lock(healthMutex);
+
+        for (size_t i = 0; i < serialNumbers.size(); ++i)
+        {
+            auto entry = health.find(serialNumbers[i]);
+
+            if (entry == health.end())
+            {
+                ProbeHealth initial{};
+                initial.serialNumber = serialNumbers[i];
+                initial.healthy      = true;
+                initial.lastError    = SUCCESS;
+                entry                = health.emplace(serialNumbers[i], initial).first;
+            }
+
+            if (record(entry->second, results[i], latencies[i]))
+            {
+                events.push_back(entry->second);
+            }
+        }
+    }
+
+    if (!events.empty())
+    {
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex);
+            pending.insert(pending.end(), events.begin(), events.end());
+        }
+
+        uv_async_send(asyncHandle);
+    }
+}
+
+bool ProbeHealthMonitor::record(ProbeHealth & probeHealth, const nrfjprogdll_err_t status,
+                                const std::chrono::microseconds latency)
+{
+    const auto wasHealthy = probeHealth.healthy;
+
+    ++probeHealth.checks;
+    probeHealth.lastCheck = std::chrono::system_clock::now();
+    probeHealth.lastError = status;
+
+    if (status == SUCCESS)
+    {
+        const auto successes = probeHealth.checks - probeHealth.failures;
+
+        probeHealth.consecutiveFailures = 0;
+        probeHealth.lastLatency         = latency;
+        probeHealth.averageLatency += (latency - probeHealth.averageLatency) / successes;
+    }
+    else
+    {
+        ++probeHealth.failures;
+        ++probeHealth.consecutiveFailures;
+    }
+
+    probeHealth.healthy = probeHealth.consecutiveFailures < options.failureThreshold;
+
+    return probeHealth.healthy != wasHealthy;
+}
+
+void ProbeHealthMonitor::deliver()
+{
+    std::vector<ProbeHealth> events;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        events.swap(pending);
+    }
+
+    Nan::HandleScope scope;
+    Nan::AsyncResource resource("pc-nrfjprog-js:health-monitor");
+
+    for (const auto & event : events)
+    {
+        v8::Local<v8::Value> argv[2];
+        argv[0] = Nan::Undefined();
+        argv[1] = ProbeHealthInfo(event).ToJs();
+
+        callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+    }
+}
+
+void ProbeHealthMonitor::onAsync(uv_async_t * handle)
+{
+    auto monitor = static_cast<ProbeHealthMonitor *>(handle->data);
+
+    if (monitor != nullptr)
+    {
+        monitor->deliver();
+    }
+}
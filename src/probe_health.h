@@ -0,0 +1,131 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROBE_HEALTH_H
+#define PROBE_HEALTH_H
+
+#include "highlevel_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ProbeHealthOptions
+{
+    std::chrono::milliseconds interval{5000};
+
+    // A probe is unhealthy after this many checks in a row have failed
+    uint32_t failureThreshold{2};
+
+    // Checked in addition to the probes that are open
+    std::vector<uint32_t> serialNumbers;
+};
+
+struct ProbeHealth
+{
+    uint32_t serialNumber;
+    bool healthy;
+    uint32_t consecutiveFailures;
+    uint32_t checks;
+    uint32_t failures;
+    nrfjprogdll_err_t lastError;
+    std::chrono::microseconds lastLatency;    // Of the last successful check
+    std::chrono::microseconds averageLatency; // Of all successful checks
+    std::chrono::system_clock::time_point lastCheck;
+};
+
+// Checks one probe and returns how long it took to connect to it
+typedef std::function<nrfjprogdll_err_t(uint32_t, std::chrono::microseconds &)> probe_check_function_t;
+typedef std::function<std::vector<uint32_t>()> probe_list_open_function_t;
+
+// Checks a set of probes on a background thread every interval, and passes a
+// JS callback an event each time a probe becomes unhealthy or healthy again,
+// through uv_async. The probes are checked at the same time, each on its own
+// thread, without the execution mutex, so a round never holds up other
+// functions. The check function is responsible for locking the lane of a probe
+// that has an RTT session.
+//
+// The monitor is created and destroyed on the JS thread, getSnapshot() may be
+// called from any thread.
+class ProbeHealthMonitor
+{
+  public:
+    ProbeHealthMonitor(const ProbeHealthOptions & options, v8::Local<v8::Function> callback);
+    ~ProbeHealthMonitor();
+
+    void start(probe_list_open_function_t listOpenProbes, probe_check_function_t check);
+    void stop();
+
+    std::vector<ProbeHealth> getSnapshot();
+
+    // Passes pending events to the JS callback, call it before the monitor is deleted
+    void deliver();
+
+  private:
+    void run();
+    std::vector<uint32_t> getMonitoredProbes();
+    void checkAll(const std::vector<uint32_t> & serialNumbers);
+    bool record(ProbeHealth & health, nrfjprogdll_err_t status, std::chrono::microseconds latency);
+
+    static void onAsync(uv_async_t * handle);
+
+    const ProbeHealthOptions options;
+
+    probe_list_open_function_t listOpenProbes;
+    probe_check_function_t check;
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    std::mutex healthMutex;
+    std::map<uint32_t, ProbeHealth> health;
+
+    std::mutex pendingMutex;
+    std::vector<ProbeHealth> pending;
+};
+
+#endif // PROBE_HEALTH_H
@@ -0,0 +1,334 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "probe_watcher.h"
+
+#include <algorithm>
+
+#include "utility/conversion.h"
+#include "utility/utility.h"
+
+// The watcher waits for the execution mutex in slices, so stop() is never blocked for long
+constexpr std::chrono::milliseconds EXECUTION_LOCK_SLICE{100};
+
+// Hotplug notifications may be missed, so the probes are still listed once in a while
+constexpr std::chrono::milliseconds HOTPLUG_FALLBACK_INTERVAL{30000};
+
+ProbeWatcher::ProbeWatcher(const ProbeWatcherOptions & _options, v8::Local<v8::Function> _callback)
+    : options(_options)
+    , executionMutex(nullptr)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , woken(false)
+    , listedOnce(false)
+    , recheckPending(false)
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+ProbeWatcher::~ProbeWatcher()
+{
+    stop();
+
+    asyncHandle->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+             [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+}
+
+void ProbeWatcher::start(std::timed_mutex & _executionMutex, probe_list_function_t _listProbes,
+                         probe_detach_function_t _onDetach)
+{
+    executionMutex = &_executionMutex;
+    listProbes     = std::move(_listProbes);
+    onDetach       = std::move(_onDetach);
+
+    if (!options.simulated)
+    {
+        hotplug = std::make_unique<HotplugMonitor>();
+    }
+
+    running = true;
+    thread  = std::thread(&ProbeWatcher::run, this);
+}
+
+void ProbeWatcher::stop()
+{
+    running = false;
+    wake();
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+bool ProbeWatcher::isSimulated() const
+{
+    return options.simulated;
+}
+
+void ProbeWatcher::setSimulatedProbes(const std::vector<uint32_t> & serialNumbers)
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        simulatedProbes = serialNumbers;
+    }
+
+    wake();
+}
+
+void ProbeWatcher::run()
+{
+    while (running)
+    {
+        std::vector<ProbeWatcherEvent> events;
+        const auto now = std::chrono::steady_clock::now();
+
+        if (recheckPending && now >= recheckAt)
+        {
+            recheckPending = false;
+        }
+
+        if (options.simulated)
+        {
+            std::vector<uint32_t> serialNumbers;
+
+            {
+                std::unique_lock<std::mutex> wakeLock(wakeMutex);
+                serialNumbers = simulatedProbes;
+            }
+
+            // Simulated probes are never opened, so there is nothing to clean up when they are detached
+            events = update(serialNumbers, now);
+        }
+        else
+        {
+            std::unique_lock<std::timed_mutex> lock(*executionMutex, std::defer_lock);
+
+            if (!lock.try_lock_for(EXECUTION_LOCK_SLICE))
+            {
+                continue;
+            }
+
+            std::vector<uint32_t> serialNumbers;
+
+            if (listProbes(serialNumbers))
+            {
+                events = update(serialNumbers, now);
+
+                for (const auto & event : events)
+                {
+                    if (!event.attached && onDetach)
+                    {
+                        onDetach(event.serialNumber);
+                    }
+                }
+            }
+        }
+
+        if (!events.empty())
+        {
+            {
+                std::unique_lock<std::mutex> lock(pendingMutex);
+                pending.insert(pending.end(), events.begin(), events.end());
+            }
+
+            uv_async_send(asyncHandle);
+        }
+
+        // A probe may not be listed yet right after its USB device is added, look again once it has settled
+        const auto changed = waitForChange(nextPollTimeout(now));
+
+        if (changed)
+        {
+            recheckPending = true;
+            recheckAt      = std::chrono::steady_clock::now() + options.debounceTime;
+        }
+    }
+}
+
+void ProbeWatcher::wake()
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        woken = true;
+    }
+
+    wakeCondition.notify_all();
+
+    if (hotplug)
+    {
+        hotplug->interrupt();
+    }
+}
+
+bool ProbeWatcher::waitForChange(const std::chrono::milliseconds timeout)
+{
+    if (hotplug)
+    {
+        return hotplug->wait(timeout);
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeCondition.wait_for(lock, timeout, [this]() { return woken; });
+
+    const auto changed = woken;
+    woken              = false;
+    return changed;
+}
+
+std::vector<ProbeWatcherEvent> ProbeWatcher::update(const std::vector<uint32_t> & serialNumbers,
+                                                    const std::chrono::steady_clock::time_point now)
+{
+    std::vector<ProbeWatcherEvent> events;
+    const std::set<uint32_t> connected(serialNumbers.begin(), serialNumbers.end());
+
+    if (!listedOnce)
+    {
+        listedOnce = true;
+
+        for (const auto serialNumber : connected)
+        {
+            attached.insert(serialNumber);
+            events.push_back({true, serialNumber});
+        }
+
+        return events;
+    }
+
+    auto candidates = connected;
+    candidates.insert(attached.begin(), attached.end());
+
+    for (const auto serialNumber : candidates)
+    {
+        const auto isConnected = connected.count(serialNumber) > 0;
+        const auto isAttached  = attached.count(serialNumber) > 0;
+
+        if (isConnected == isAttached)
+        {
+            changedSince.erase(serialNumber);
+            continue;
+        }
+
+        const auto since = changedSince.emplace(serialNumber, now).first;
+
+        if (now - since->second < options.debounceTime)
+        {
+            continue;
+        }
+
+        if (isConnected)
+        {
+            attached.insert(serialNumber);
+        }
+        else
+        {
+            attached.erase(serialNumber);
+        }
+
+        changedSince.erase(since);
+        events.push_back({isConnected, serialNumber});
+    }
+
+    return events;
+}
+
+std::chrono::milliseconds ProbeWatcher::nextPollTimeout(const std::chrono::steady_clock::time_point now) const
+{
+    // With hotplug notifications, polling only catches the changes that were not notified
+    const auto interval = hotplug && hotplug->isAvailable() ? std::max(options.pollInterval, HOTPLUG_FALLBACK_INTERVAL)
+                                                            : options.pollInterval;
+    auto next = now + interval;
+
+    for (const auto & change : changedSince)
+    {
+        next = std::min(next, change.second + options.debounceTime);
+    }
+
+    if (recheckPending)
+    {
+        next = std::min(next, recheckAt);
+    }
+
+    const auto remaining = next - std::chrono::steady_clock::now();
+    auto timeout         = std::chrono::duration_cast<std::chrono::milliseconds>(remaining);
+
+    // Round up, waking up just before a debounce deadline would only poll twice
+    if (timeout < remaining)
+    {
+        ++timeout;
+    }
+
+    return std::max(timeout, std::chrono::milliseconds(0));
+}
+
+void ProbeWatcher::deliver()
+{
+    std::vector<ProbeWatcherEvent> events;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        events.swap(pending);
+    }
+
+    Nan::HandleScope scope;
+    Nan::AsyncResource resource("pc-nrfjprog-js:probe-watcher");
+
+    for (const auto & event : events)
+    {
+        v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+        Utility::Set(obj, "type", Convert::toJsString(event.attached ? "attach" : "detach"));
+        Utility::Set(obj, "serialNumber", Convert::toJsNumber(event.serialNumber));
+
+        v8::Local<v8::Value> argv[2];
+        argv[0] = Nan::Undefined();
+        argv[1] = obj;
+
+        callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+    }
+}
+
+void ProbeWatcher::onAsync(uv_async_t * handle)
+{
+    auto watcher = static_cast<ProbeWatcher *>(handle->data);
+
+    if (watcher != nullptr)
+    {
+        watcher->deliver();
+    }
+}
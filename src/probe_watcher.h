@@ -0,0 +1,141 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROBE_WATCHER_H
+#define PROBE_WATCHER_H
+
+#include "highlevel_common.h"
+#include "hotplug.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+struct ProbeWatcherOptions
+{
+    std::chrono::milliseconds pollInterval{1000};
+    std::chrono::milliseconds debounceTime{500};
+
+    // Probes are taken from setSimulatedProbes() instead of the connected probes
+    bool simulated{false};
+};
+
+struct ProbeWatcherEvent
+{
+    bool attached;
+    uint32_t serialNumber;
+};
+
+// Returns false if the connected probes could not be listed this time
+typedef std::function<bool(std::vector<uint32_t> &)> probe_list_function_t;
+typedef std::function<void(uint32_t)> probe_detach_function_t;
+
+// Lists the connected probes on a background thread and passes attach and
+// detach events to a JS callback through uv_async. A probe has to stay
+// attached or detached for the debounce time before it is reported. Probes
+// that are connected when the watcher starts are reported right away.
+//
+// Where the platform has hotplug notifications the probes are listed as soon
+// as a USB device is added or removed, and only every fallback interval
+// otherwise. Without them they are listed every poll interval.
+//
+// Probes are listed and detached probes are cleaned up while holding the
+// execution mutex. Simulated probes need neither. The watcher is created and
+// destroyed on the JS thread.
+class ProbeWatcher
+{
+  public:
+    ProbeWatcher(const ProbeWatcherOptions & options, v8::Local<v8::Function> callback);
+    ~ProbeWatcher();
+
+    void start(std::timed_mutex & executionMutex, probe_list_function_t listProbes,
+               probe_detach_function_t onDetach);
+    void stop();
+
+    bool isSimulated() const;
+    void setSimulatedProbes(const std::vector<uint32_t> & serialNumbers);
+
+    // Passes pending events to the JS callback, call it before the watcher is deleted
+    void deliver();
+
+  private:
+    void run();
+    void wake();
+    bool waitForChange(std::chrono::milliseconds timeout);
+    std::vector<ProbeWatcherEvent> update(const std::vector<uint32_t> & serialNumbers,
+                                          std::chrono::steady_clock::time_point now);
+    std::chrono::milliseconds nextPollTimeout(std::chrono::steady_clock::time_point now) const;
+
+    static void onAsync(uv_async_t * handle);
+
+    const ProbeWatcherOptions options;
+
+    std::timed_mutex * executionMutex;
+    probe_list_function_t listProbes;
+    probe_detach_function_t onDetach;
+
+    std::unique_ptr<HotplugMonitor> hotplug;
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool woken;
+
+    std::vector<uint32_t> simulatedProbes;
+
+    // Only used by the watcher thread
+    bool listedOnce;
+    std::set<uint32_t> attached;
+    std::map<uint32_t, std::chrono::steady_clock::time_point> changedSince;
+    bool recheckPending;
+    std::chrono::steady_clock::time_point recheckAt;
+
+    std::mutex pendingMutex;
+    std::vector<ProbeWatcherEvent> pending;
+};
+
+#endif // PROBE_WATCHER_H
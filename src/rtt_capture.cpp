@@ -0,0 +1,188 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_capture.h"
+
+#include <cstdio>
+#include <sstream>
+
+RttCaptureFile::RttCaptureFile(const std::string & _path, const RttCaptureOptions & _options)
+    : path(_path)
+    , options(_options)
+    , fileSize(0)
+    , statistics{0, 0, 0, 0}
+{}
+
+bool RttCaptureFile::open()
+{
+    file.open(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    fileSize = 0;
+
+    if (hasIndex())
+    {
+        index.open(path + ".index", std::ios_base::out | std::ios_base::trunc);
+        return file.is_open() && index.is_open();
+    }
+
+    return file.is_open();
+}
+
+bool RttCaptureFile::write(const char * data, const uint32_t length, const std::chrono::microseconds time)
+{
+    char timestamp[32];
+    std::snprintf(timestamp,
+                  sizeof(timestamp),
+                  "%llu.%06llu",
+                  static_cast<unsigned long long>(time.count() / 1000000),
+                  static_cast<unsigned long long>(time.count() % 1000000));
+
+    // Records are separated the way they were framed, raw data has no records to separate
+    std::string prefix;
+    std::string suffix;
+
+    if (options.framing == RTT_FRAMING_LINE)
+    {
+        prefix = options.timestamps ? std::string("[") + timestamp + "] " : std::string();
+        suffix = "\n";
+    }
+    else if (options.framing == RTT_FRAMING_LENGTH_PREFIX)
+    {
+        for (uint32_t i = 0; i < options.lengthPrefixSize; ++i)
+        {
+            prefix.push_back(static_cast<char>((static_cast<uint64_t>(length) >> (8 * i)) & 0xFF));
+        }
+    }
+
+    const auto recordSize = prefix.size() + length + suffix.size();
+
+    statistics.bytesReceived += length;
+
+    if (options.maxFileSize > 0 && fileSize > 0 && fileSize + recordSize > options.maxFileSize && !rotate())
+    {
+        return false;
+    }
+
+    if (hasIndex())
+    {
+        index << fileSize << ' ' << timestamp << '\n';
+    }
+
+    file.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+    file.write(data, length);
+    file.write(suffix.data(), static_cast<std::streamsize>(suffix.size()));
+
+    fileSize += recordSize;
+    statistics.bytesWritten += recordSize;
+    ++statistics.records;
+
+    return file.good() && (!hasIndex() || index.good());
+}
+
+bool RttCaptureFile::flush()
+{
+    file.flush();
+
+    if (hasIndex())
+    {
+        index.flush();
+        return file.good() && index.good();
+    }
+
+    return file.good();
+}
+
+const std::string & RttCaptureFile::getPath() const
+{
+    return path;
+}
+
+const RttCaptureOptions & RttCaptureFile::getOptions() const
+{
+    return options;
+}
+
+RttCaptureStatistics RttCaptureFile::getStatistics() const
+{
+    return statistics;
+}
+
+bool RttCaptureFile::rotate()
+{
+    file.close();
+    index.close();
+
+    // The index of each file is rotated along with it, as path.N.index
+    const std::string suffixes[] = {"", ".index"};
+
+    for (const auto & suffix : suffixes)
+    {
+        if (!suffix.empty() && !hasIndex())
+        {
+            continue;
+        }
+
+        if (options.maxFiles == 0)
+        {
+            std::remove((path + suffix).c_str());
+            continue;
+        }
+
+        std::remove((rotatedPath(options.maxFiles) + suffix).c_str());
+
+        for (auto number = options.maxFiles; number > 1; --number)
+        {
+            std::rename((rotatedPath(number - 1) + suffix).c_str(), (rotatedPath(number) + suffix).c_str());
+        }
+
+        std::rename((path + suffix).c_str(), (rotatedPath(1) + suffix).c_str());
+    }
+
+    ++statistics.rotations;
+
+    return open();
+}
+
+bool RttCaptureFile::hasIndex() const
+{
+    return options.timestamps && options.framing != RTT_FRAMING_LINE;
+}
+
+std::string RttCaptureFile::rotatedPath(const uint32_t number) const
+{
+    std::ostringstream stream;
+    stream << path << "." << number;
+    return stream.str();
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_CAPTURE_H
+#define RTT_CAPTURE_H
+
+#include "highlevel_common.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+struct RttCaptureOptions
+{
+    uint32_t maxFileSize{0}; // 0 disables rotation
+    uint32_t maxFiles{10};
+    bool timestamps{false};
+    std::chrono::milliseconds statisticsInterval{1000};
+
+    // The framing of the records that are written, from the reader options
+    rtt_framing_t framing{RTT_FRAMING_NONE};
+    uint32_t lengthPrefixSize{2};
+};
+
+struct RttCaptureStatistics
+{
+    uint64_t bytesReceived;
+    uint64_t bytesWritten;
+    uint64_t records;
+    uint32_t rotations;
+};
+
+// Writes the records of one RTT up channel to a file. When the file would grow
+// beyond maxFileSize, it is rotated: path is renamed to path.1, path.1 to path.2
+// and so on, keeping maxFiles old files. Lines are written with a newline, length
+// prefixed records with their length prefix, and raw data as it was read.
+//
+// With timestamps, lines are prefixed with the time they were received. Binary
+// data is left as it is, and the times go to a side index at path.index instead,
+// one text line per record with its offset in the file and the time. The index
+// is rotated together with the file.
+class RttCaptureFile
+{
+  public:
+    RttCaptureFile(const std::string & path, const RttCaptureOptions & options);
+
+    bool open();
+    bool write(const char * data, uint32_t length, std::chrono::microseconds time);
+    bool flush();
+
+    const std::string & getPath() const;
+    const RttCaptureOptions & getOptions() const;
+    RttCaptureStatistics getStatistics() const;
+
+  private:
+    bool rotate();
+    std::string rotatedPath(uint32_t number) const;
+    bool hasIndex() const;
+
+    const std::string path;
+    const RttCaptureOptions options;
+
+    std::ofstream file;
+    std::ofstream index;
+    uint64_t fileSize;
+
+    RttCaptureStatistics statistics;
+};
+
+#endif // RTT_CAPTURE_H
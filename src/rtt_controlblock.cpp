@@ -0,0 +1,265 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_controlblock.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "dll_call.h"
+
+namespace
+{
+const char CONTROL_BLOCK_ID[]          = "SEGGER RTT";
+const uint32_t CONTROL_BLOCK_ID_LENGTH = sizeof(CONTROL_BLOCK_ID) - 1;
+
+// Large enough to keep the number of reads low, small enough to not stall the probe
+const uint32_t SEARCH_READ_LENGTH = 4096;
+
+const char CONTROL_BLOCK_SYMBOL[] = "_SEGGER_RTT";
+
+const uint32_t ELF_HEADER_LENGTH         = 52;
+const uint32_t ELF_SECTION_HEADER_LENGTH = 40;
+const uint32_t ELF_SYMBOL_LENGTH         = 16;
+const uint8_t ELF_CLASS_32               = 1;
+const uint8_t ELF_DATA_LITTLE_ENDIAN     = 1;
+const uint32_t ELF_SECTION_SYMTAB        = 2;
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME        = 1099511628211ULL;
+
+struct ElfLookup
+{
+    bool found;
+    uint32_t address;
+};
+
+// Images are identified by their contents, so a rebuilt firmware at the same path is parsed again
+std::mutex elfCacheMutex;
+std::map<uint64_t, ElfLookup> elfCache;
+
+uint64_t fnv1a(const std::vector<uint8_t> & data)
+{
+    auto hash = FNV_OFFSET_BASIS;
+
+    for (const auto byte : data)
+    {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+bool readU16(const std::vector<uint8_t> & image, const uint32_t offset, uint32_t & value)
+{
+    if (offset > image.size() || image.size() - offset < 2)
+    {
+        return false;
+    }
+
+    value = static_cast<uint32_t>(image[offset]) | static_cast<uint32_t>(image[offset + 1]) << 8U;
+    return true;
+}
+
+bool readU32(const std::vector<uint8_t> & image, const uint32_t offset, uint32_t & value)
+{
+    if (offset > image.size() || image.size() - offset < 4)
+    {
+        return false;
+    }
+
+    value = static_cast<uint32_t>(image[offset]) | static_cast<uint32_t>(image[offset + 1]) << 8U |
+            static_cast<uint32_t>(image[offset + 2]) << 16U | static_cast<uint32_t>(image[offset + 3]) << 24U;
+    return true;
+}
+
+// Returns false if the image is malformed, found tells if the symbol is in it
+bool parseElf(const std::vector<uint8_t> & image, ElfLookup & lookup)
+{
+    lookup.found = false;
+
+    if (image.size() < ELF_HEADER_LENGTH || image[0] != 0x7F || image[1] != 'E' || image[2] != 'L' ||
+        image[3] != 'F' || image[4] != ELF_CLASS_32 || image[5] != ELF_DATA_LITTLE_ENDIAN)
+    {
+        return false;
+    }
+
+    uint32_t sectionHeaderOffset;
+    uint32_t sectionHeaderLength;
+    uint32_t sectionCount;
+
+    if (!readU32(image, 32, sectionHeaderOffset) || !readU16(image, 46, sectionHeaderLength) ||
+        !readU16(image, 48, sectionCount) || sectionHeaderLength < ELF_SECTION_HEADER_LENGTH)
+    {
+        return false;
+    }
+
+    for (uint32_t section = 0; section < sectionCount; ++section)
+    {
+        const auto header = sectionHeaderOffset + section * sectionHeaderLength;
+        uint32_t type;
+
+        if (!readU32(image, header + 4, type))
+        {
+            return false;
+        }
+
+        if (type != ELF_SECTION_SYMTAB)
+        {
+            continue;
+        }
+
+        uint32_t symbolsOffset;
+        uint32_t symbolsLength;
+        uint32_t stringSection;
+        uint32_t stringsOffset;
+        uint32_t stringsLength;
+
+        if (!readU32(image, header + 16, symbolsOffset) || !readU32(image, header + 20, symbolsLength) ||
+            !readU32(image, header + 24, stringSection) || stringSection >= sectionCount)
+        {
+            return false;
+        }
+
+        // The symbol names are in the string table the symbol table links to
+        const auto stringHeader = sectionHeaderOffset + stringSection * sectionHeaderLength;
+
+        if (!readU32(image, stringHeader + 16, stringsOffset) || !readU32(image, stringHeader + 20, stringsLength) ||
+            stringsOffset > image.size() || image.size() - stringsOffset < stringsLength)
+        {
+            return false;
+        }
+
+        for (uint32_t symbol = 0; symbol + ELF_SYMBOL_LENGTH <= symbolsLength; symbol += ELF_SYMBOL_LENGTH)
+        {
+            uint32_t name;
+            uint32_t value;
+
+            if (!readU32(image, symbolsOffset + symbol, name) || !readU32(image, symbolsOffset + symbol + 4, value))
+            {
+                return false;
+            }
+
+            if (name >= stringsLength ||
+                stringsLength - name < sizeof(CONTROL_BLOCK_SYMBOL) ||
+                std::memcmp(&image[stringsOffset + name], CONTROL_BLOCK_SYMBOL, sizeof(CONTROL_BLOCK_SYMBOL)) != 0)
+            {
+                continue;
+            }
+
+            lookup.found   = true;
+            lookup.address = value;
+            return true;
+        }
+    }
+
+    return true;
+}
+} // namespace
+
+nrfjprogdll_err_t findRttControlBlock(Probe_handle_t probe, const uint32_t start, const uint32_t length, bool & found,
+                                      uint32_t & address)
+{
+    std::vector<uint8_t> buffer(SEARCH_READ_LENGTH);
+
+    found = false;
+
+    // Consecutive reads overlap, so an ID across two reads is found as well
+    for (uint32_t offset = 0; offset + CONTROL_BLOCK_ID_LENGTH <= length;
+         offset += SEARCH_READ_LENGTH - (CONTROL_BLOCK_ID_LENGTH - 1))
+    {
+        const auto readLength = std::min(SEARCH_READ_LENGTH, length - offset);
+        const auto status =
+            DLL_TRANSFER(THROUGHPUT_READ, readLength, NRFJPROG_read, probe, start + offset, buffer.data(), readLength);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+
+        const auto end = buffer.begin() + readLength;
+        const auto it  = std::search(buffer.begin(), end, CONTROL_BLOCK_ID, CONTROL_BLOCK_ID + CONTROL_BLOCK_ID_LENGTH);
+
+        if (it != end)
+        {
+            found   = true;
+            address = start + offset + static_cast<uint32_t>(it - buffer.begin());
+            return SUCCESS;
+        }
+    }
+
+    return SUCCESS;
+}
+
+nrfjprogdll_err_t findRttControlBlockInElf(const std::string & path, bool & found, uint32_t & address)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        return INVALID_PARAMETER;
+    }
+
+    const std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const auto hash = fnv1a(image);
+
+    std::unique_lock<std::mutex> lock(elfCacheMutex);
+
+    auto cached = elfCache.find(hash);
+
+    if (cached == elfCache.end())
+    {
+        ElfLookup lookup{};
+
+        if (!parseElf(image, lookup))
+        {
+            return INVALID_PARAMETER;
+        }
+
+        cached = elfCache.emplace(hash, lookup).first;
+    }
+
+    found   = cached->second.found;
+    address = cached->second.address;
+
+    return SUCCESS;
+}
@@ -0,0 +1,157 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_framer.h"
+
+#include <algorithm>
+
+RttFramer::RttFramer(const RttFramingOptions & _options)
+    : options(_options)
+    , hasRecordLength(false)
+    , recordLength(0)
+    , droppedLength(0)
+{}
+
+void RttFramer::push(const char * data, const uint32_t length, std::vector<std::vector<char>> & records)
+{
+    if (options.mode == RTT_FRAMING_LINE)
+    {
+        pushLine(data, length, records);
+    }
+    else if (options.mode == RTT_FRAMING_LENGTH_PREFIX)
+    {
+        pushLengthPrefixed(data, length, records);
+    }
+    else
+    {
+        records.emplace_back(data, data + length);
+    }
+}
+
+uint64_t RttFramer::takeDroppedLength()
+{
+    const auto dropped = droppedLength;
+    droppedLength      = 0;
+    return dropped;
+}
+
+void RttFramer::pushLine(const char * data, const uint32_t length, std::vector<std::vector<char>> & records)
+{
+    const auto end = data + length;
+    auto position  = data;
+
+    while (position != end)
+    {
+        const auto newline = std::find(position, end, '\n');
+        const auto room    = options.maxLineLength - static_cast<uint32_t>(partial.size());
+
+        if (static_cast<uint32_t>(newline - position) > room)
+        {
+            // Too long for one record, deliver what fits
+            partial.insert(partial.end(), position, position + room);
+            records.push_back(std::move(partial));
+            partial.clear();
+            position += room;
+            continue;
+        }
+
+        partial.insert(partial.end(), position, newline);
+
+        if (newline == end)
+        {
+            break;
+        }
+
+        if (!partial.empty() && partial.back() == '\r')
+        {
+            partial.pop_back();
+        }
+
+        records.push_back(std::move(partial));
+        partial.clear();
+        position = newline + 1;
+    }
+}
+
+void RttFramer::pushLengthPrefixed(const char * data, const uint32_t length, std::vector<std::vector<char>> & records)
+{
+    const auto end = data + length;
+    auto position  = data;
+
+    while (position != end)
+    {
+        const auto wanted = hasRecordLength ? recordLength : options.lengthPrefixSize;
+        const auto count =
+            std::min(static_cast<uint32_t>(end - position), wanted - static_cast<uint32_t>(partial.size()));
+
+        partial.insert(partial.end(), position, position + count);
+        position += count;
+
+        if (partial.size() < wanted)
+        {
+            break;
+        }
+
+        if (!hasRecordLength)
+        {
+            recordLength = 0;
+            for (uint32_t i = 0; i < options.lengthPrefixSize; ++i)
+            {
+                recordLength |= static_cast<uint32_t>(static_cast<uint8_t>(partial[i])) << (8 * i);
+            }
+
+            if (recordLength > options.maxRecordLength)
+            {
+                // Out of sync, try the prefix that starts at the next byte
+                partial.erase(partial.begin());
+                ++droppedLength;
+                continue;
+            }
+
+            hasRecordLength = true;
+            partial.clear();
+
+            if (recordLength > 0)
+            {
+                continue;
+            }
+        }
+
+        records.push_back(std::move(partial));
+        partial.clear();
+        hasRecordLength = false;
+    }
+}
@@ -0,0 +1,85 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_FRAMER_H
+#define RTT_FRAMER_H
+
+#include "highlevel_common.h"
+
+#include <cstdint>
+#include <vector>
+
+struct RttFramingOptions
+{
+    rtt_framing_t mode{RTT_FRAMING_NONE};
+    uint32_t lengthPrefixSize{2};
+    uint32_t maxLineLength{4096};
+    uint32_t maxRecordLength{65536};
+};
+
+// Splits the data stream of one up channel into records. In line mode a record
+// ends with a newline, which is stripped together with a preceding carriage
+// return. Lines longer than maxLineLength are split. In length prefix mode every
+// record starts with its length as a little endian integer of lengthPrefixSize
+// bytes, which is not part of the record. A prefix above maxRecordLength can only
+// come from corrupt or misaligned data, so its first byte is dropped and the
+// prefix is looked for again one byte later, until the stream is back in sync.
+class RttFramer
+{
+  public:
+    explicit RttFramer(const RttFramingOptions & options);
+
+    // Appends received data and moves every record it completes to records
+    void push(const char * data, uint32_t length, std::vector<std::vector<char>> & records);
+
+    // The number of bytes dropped to find a valid length prefix since the last call
+    uint64_t takeDroppedLength();
+
+  private:
+    void pushLine(const char * data, uint32_t length, std::vector<std::vector<char>> & records);
+    void pushLengthPrefixed(const char * data, uint32_t length, std::vector<std::vector<char>> & records);
+
+    const RttFramingOptions options;
+
+    std::vector<char> partial;
+
+    // Length prefix mode only, the prefix is collected in partial until complete
+    bool hasRecordLength;
+    uint32_t recordLength;
+    uint64_t droppedLength;
+};
+
+#endif // RTT_FRAMER_H
@@ -0,0 +1,585 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_reader.h"
+
+#include <algorithm>
+
+#include "dll_call.h"
+#include "log_ring.h"
+#include "utility/conversion.h"
+#include "utility/errormessage.h"
+#include "utility/utility.h"
+
+// Upper bound on consecutive reads from one channel in a single poll, so that a
+// busy channel cannot starve the other channels or the session lane.
+constexpr int MAX_DRAIN_READS = 16;
+
+RttReader::RttReader(const std::vector<uint32_t> & _channels, const RttReaderOptions & _options,
+                     v8::Local<v8::Function> _callback)
+    : channels(_channels)
+    , options(_options)
+    , kind(RTT_READER_SUBSCRIPTION)
+    , probe(nullptr)
+    , laneMutex(nullptr)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , readBuffer(_options.readLength)
+    , captureFailed(false)
+    , pendingError(SUCCESS)
+    , pendingCaptureFailed(false)
+    , statisticsDue(false)
+    , pendingStatistics{}
+{
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        framers.emplace_back(options.framing);
+    }
+
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+RttReader::RttReader(const std::vector<uint32_t> & _channels, const RttReaderOptions & _options,
+                     const uint32_t bufferSize)
+    : channels(_channels)
+    , options(_options)
+    , kind(RTT_READER_BUFFER)
+    , probe(nullptr)
+    , laneMutex(nullptr)
+    , asyncHandle(nullptr)
+    , running(false)
+    , readBuffer(_options.readLength)
+    , captureFailed(false)
+    , pendingError(SUCCESS)
+    , pendingCaptureFailed(false)
+    , statisticsDue(false)
+    , pendingStatistics{}
+{
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        ringBuffers.push_back(std::make_unique<RttRingBuffer>(bufferSize));
+    }
+}
+
+RttReader::RttReader(const uint32_t channelIndex, const RttReaderOptions & _options,
+                     std::unique_ptr<RttCaptureFile> _capture, v8::Local<v8::Function> _callback)
+    : channels{channelIndex}
+    , options(_options)
+    , kind(RTT_READER_CAPTURE)
+    , probe(nullptr)
+    , laneMutex(nullptr)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , readBuffer(_options.readLength)
+    , capture(std::move(_capture))
+    , captureFailed(false)
+    , pendingError(SUCCESS)
+    , pendingCaptureFailed(false)
+    , statisticsDue(false)
+    , pendingStatistics{}
+{
+    framers.emplace_back(options.framing);
+
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+RttReader::RttReader(const uint32_t channelIndex, const RttReaderOptions & _options,
+                     std::unique_ptr<RttSharedRing> _sharedRing, v8::Local<v8::Function> _callback)
+    : channels{channelIndex}
+    , options(_options)
+    , kind(RTT_READER_SHARED_RING)
+    , probe(nullptr)
+    , laneMutex(nullptr)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , readBuffer(_options.readLength)
+    , captureFailed(false)
+    , sharedRing(std::move(_sharedRing))
+    , pendingError(SUCCESS)
+    , pendingCaptureFailed(false)
+    , statisticsDue(false)
+    , pendingStatistics{}
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+RttReader::~RttReader()
+{
+    stop();
+
+    if (asyncHandle != nullptr)
+    {
+        asyncHandle->data = nullptr;
+        uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+                 [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+    }
+}
+
+void RttReader::start(Probe_handle_t _probe, std::chrono::high_resolution_clock::time_point _startTime,
+                      std::timed_mutex & _laneMutex, rtt_recovery_function_t _recover)
+{
+    probe       = _probe;
+    laneMutex   = &_laneMutex;
+    traceTrack  = OperationTrace::currentTrack();
+    recover     = std::move(_recover);
+    startTime   = _startTime;
+    startOffset = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
+                                                                        startTime);
+    steadyStart = std::chrono::steady_clock::now();
+    lastStatistics = steadyStart;
+    running     = true;
+    thread    = std::thread(&RttReader::run, this);
+}
+
+void RttReader::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+
+    wakeCondition.notify_all();
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+Probe_handle_t RttReader::getProbe() const
+{
+    return probe;
+}
+
+rtt_reader_kind_t RttReader::getKind() const
+{
+    return kind;
+}
+
+bool RttReader::isRunning() const
+{
+    return running;
+}
+
+bool RttReader::openCapture()
+{
+    return capture && capture->open();
+}
+
+nrfjprogdll_err_t RttReader::getError()
+{
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    return pendingError;
+}
+
+bool RttReader::readBuffered(const uint32_t channelIndex, char * data, const uint32_t length, uint32_t & readLength)
+{
+    for (size_t i = 0; i < ringBuffers.size(); ++i)
+    {
+        if (channels[i] == channelIndex)
+        {
+            readLength = ringBuffers[i]->read(data, length, std::chrono::steady_clock::now());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> RttReader::getBufferStatistics()
+{
+    std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> statistics;
+
+    for (size_t i = 0; i < ringBuffers.size(); ++i)
+    {
+        statistics.emplace_back(channels[i], ringBuffers[i]->getStatistics());
+    }
+
+    return statistics;
+}
+
+void RttReader::release(std::unique_ptr<RttReader> reader)
+{
+    if (reader->asyncHandle == nullptr)
+    {
+        reader.reset();
+        return;
+    }
+
+    reader->stop();
+
+    if (reader->capture)
+    {
+        reader->storeStatistics();
+    }
+
+    // The reader is deleted by onAsync from here on
+    auto handle = reader->asyncHandle;
+    reader.release()->releasing.request(handle);
+}
+
+void RttReader::run()
+{
+    OperationTrace::TrackScope trackScope(traceTrack);
+
+    auto interval = options.minPollInterval;
+
+    while (running)
+    {
+        auto receivedData = false;
+        auto status       = SUCCESS;
+
+        {
+            std::unique_lock<std::timed_mutex> lock(*laneMutex, std::defer_lock);
+
+            if (lock.try_lock_for(options.maxPollInterval))
+            {
+                status = poll(receivedData);
+
+                // A target reset invalidates the control block, continue on the re-armed one
+                if (status != SUCCESS && recover)
+                {
+                    status = recover(status);
+                }
+            }
+        }
+
+        if (status != SUCCESS || captureFailed)
+        {
+            {
+                std::unique_lock<std::mutex> lock(pendingMutex);
+                pendingError         = status;
+                pendingCaptureFailed = captureFailed;
+            }
+
+            if (capture)
+            {
+                storeStatistics();
+            }
+
+            if (sharedRing)
+            {
+                sharedRing->setState(RTT_SHARED_RING_FAILED);
+            }
+
+            running = false;
+            notify();
+            return;
+        }
+
+        if (capture && std::chrono::steady_clock::now() - lastStatistics >= capture->getOptions().statisticsInterval)
+        {
+            lastStatistics = std::chrono::steady_clock::now();
+            storeStatistics();
+            notify();
+        }
+
+        if (receivedData)
+        {
+            if (!capture && !sharedRing)
+            {
+                notify();
+            }
+
+            interval = options.minPollInterval;
+        }
+        else
+        {
+            interval = std::min(interval * 2, options.maxPollInterval);
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, interval, [this] { return !running; });
+    }
+
+    if (sharedRing)
+    {
+        sharedRing->setState(RTT_SHARED_RING_STOPPED);
+    }
+}
+
+void RttReader::frame(const size_t channel, const uint32_t readLength)
+{
+    framers[channel].push(readBuffer.data(), readLength, records);
+
+    const auto droppedLength = framers[channel].takeDroppedLength();
+
+    if (droppedLength > 0)
+    {
+        LogRing::add(LOG_LEVEL_WARNING,
+                     "RTT channel " + std::to_string(channels[channel]) + ": dropped " +
+                         std::to_string(droppedLength) + " bytes to find a record length of at most " +
+                         std::to_string(options.framing.maxRecordLength));
+    }
+}
+
+std::chrono::microseconds RttReader::now() const
+{
+    return startOffset +
+           std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - steadyStart);
+}
+
+void RttReader::storeStatistics()
+{
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    pendingStatistics = capture->getStatistics();
+    statisticsDue     = true;
+}
+
+void RttReader::notify()
+{
+    if (asyncHandle != nullptr)
+    {
+        uv_async_send(asyncHandle);
+    }
+}
+
+nrfjprogdll_err_t RttReader::poll(bool & receivedData)
+{
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+    {
+        const auto channelIndex = channels[channel];
+
+        for (auto i = 0; i < MAX_DRAIN_READS; ++i)
+        {
+            uint32_t readLength = 0;
+
+            const auto status = DLL_TRANSFER(THROUGHPUT_RTT_UP,
+                                             readLength,
+                                             NRFJPROG_rtt_read,
+                                             probe,
+                                             channelIndex,
+                                             readBuffer.data(),
+                                             options.readLength,
+                                             &readLength);
+
+            if (status != SUCCESS)
+            {
+                return status;
+            }
+
+            if (readLength == 0)
+            {
+                break;
+            }
+
+            receivedData = true;
+
+            if (!ringBuffers.empty())
+            {
+                ringBuffers[channel]->write(readBuffer.data(), readLength, std::chrono::steady_clock::now());
+            }
+            else if (sharedRing)
+            {
+                sharedRing->write(readBuffer.data(), readLength);
+            }
+            else if (capture)
+            {
+                const auto receiveTime = now();
+
+                frame(channel, readLength);
+
+                for (const auto & record : records)
+                {
+                    captureFailed |=
+                        !capture->write(record.data(), static_cast<uint32_t>(record.size()), receiveTime);
+                }
+            }
+            else
+            {
+                const auto receiveTime = now();
+
+                frame(channel, readLength);
+
+                std::unique_lock<std::mutex> lock(pendingMutex);
+                for (auto & record : records)
+                {
+                    pending.push_back(RttChunk{channelIndex, std::move(record), receiveTime});
+                }
+            }
+
+            records.clear();
+
+            if (readLength < options.readLength)
+            {
+                break;
+            }
+        }
+    }
+
+    if (capture && receivedData && !capture->flush())
+    {
+        captureFailed = true;
+    }
+
+    return SUCCESS;
+}
+
+void RttReader::deliver()
+{
+    if (capture)
+    {
+        deliverStatistics();
+        return;
+    }
+
+    std::vector<RttChunk> chunks;
+    nrfjprogdll_err_t error;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        chunks.swap(pending);
+        error        = pendingError;
+        pendingError = SUCCESS;
+    }
+
+    if (chunks.empty() && error == SUCCESS)
+    {
+        return;
+    }
+
+    Nan::HandleScope scope;
+
+    if (sharedRing)
+    {
+        v8::Local<v8::Value> argv[1];
+        argv[0] = ErrorMessage::getErrorMessage(CouldNotRead, nrfjprog_js_err_map, "rtt shared ring read", "", error);
+
+        Nan::AsyncResource resource("pc-nrfjprog-js:rtt-shared-ring");
+        callback->Call(1, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+        return;
+    }
+
+    v8::Local<v8::Array> jsChunks = Nan::New<v8::Array>();
+    uint32_t i                    = 0;
+
+    for (auto & chunk : chunks)
+    {
+        v8::Local<v8::Object> chunkObj = Nan::New<v8::Object>();
+        Utility::Set(chunkObj, "channelIndex", Convert::toJsNumber(chunk.channelIndex));
+        Utility::Set(chunkObj,
+                     "data",
+                     Convert::toJsBuffer(chunk.data.data(), static_cast<uint32_t>(chunk.data.size())));
+        Utility::Set(chunkObj, "time", Convert::toJsNumber(static_cast<double>(chunk.time.count())));
+
+        Nan::Set(jsChunks, i, chunkObj);
+        ++i;
+    }
+
+    v8::Local<v8::Value> argv[2];
+    argv[0] = ErrorMessage::getErrorMessage(
+        error == SUCCESS ? JsSuccess : CouldNotRead, nrfjprog_js_err_map, "rtt subscription read", "", error);
+    argv[1] = jsChunks;
+
+    Nan::AsyncResource resource("pc-nrfjprog-js:rtt-subscription");
+    callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+}
+
+void RttReader::deliverStatistics()
+{
+    RttCaptureStatistics statistics;
+    bool due;
+    nrfjprogdll_err_t error;
+    bool failed;
+
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        statistics           = pendingStatistics;
+        due                  = statisticsDue;
+        statisticsDue        = false;
+        error                = pendingError;
+        pendingError         = SUCCESS;
+        failed               = pendingCaptureFailed;
+        pendingCaptureFailed = false;
+    }
+
+    if (!due && error == SUCCESS && !failed)
+    {
+        return;
+    }
+
+    Nan::HandleScope scope;
+
+    v8::Local<v8::Object> statisticsObj = Nan::New<v8::Object>();
+    Utility::Set(statisticsObj, "path", Convert::toJsString(capture->getPath()));
+    Utility::Set(statisticsObj, "bytesReceived", Convert::toJsNumber(static_cast<double>(statistics.bytesReceived)));
+    Utility::Set(statisticsObj, "bytesWritten", Convert::toJsNumber(static_cast<double>(statistics.bytesWritten)));
+    Utility::Set(statisticsObj, "records", Convert::toJsNumber(static_cast<double>(statistics.records)));
+    Utility::Set(statisticsObj, "rotations", Convert::toJsNumber(statistics.rotations));
+
+    v8::Local<v8::Value> argv[2];
+
+    if (failed)
+    {
+        argv[0] = ErrorMessage::getErrorMessage(
+            CouldNotCallFunction, nrfjprog_js_err_map, "rtt capture write to " + capture->getPath());
+    }
+    else
+    {
+        argv[0] = ErrorMessage::getErrorMessage(
+            error == SUCCESS ? JsSuccess : CouldNotRead, nrfjprog_js_err_map, "rtt capture read", "", error);
+    }
+
+    argv[1] = statisticsObj;
+
+    Nan::AsyncResource resource("pc-nrfjprog-js:rtt-capture");
+    callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+}
+
+void RttReader::onAsync(uv_async_t * handle)
+{
+    auto reader = static_cast<RttReader *>(handle->data);
+
+    if (reader == nullptr)
+    {
+        return;
+    }
+
+    const auto released = reader->releasing.isRequested();
+
+    reader->deliver();
+
+    if (released)
+    {
+        delete reader;
+    }
+}
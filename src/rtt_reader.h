@@ -0,0 +1,178 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_READER_H
+#define RTT_READER_H
+
+#include "async_release.h"
+#include "highlevel_common.h"
+#include "rtt_capture.h"
+#include "rtt_framer.h"
+#include "rtt_ringbuffer.h"
+#include "rtt_sharedring.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct RttReaderOptions
+{
+    std::chrono::milliseconds minPollInterval{1};
+    std::chrono::milliseconds maxPollInterval{50};
+    uint32_t readLength{1024};
+    RttFramingOptions framing;
+};
+
+struct RttChunk
+{
+    uint32_t channelIndex;
+    std::vector<char> data;
+    std::chrono::microseconds time; // Since RTT was started
+};
+
+// Polls a set of RTT up channels on a background thread and pushes the received
+// data to a JS callback through uv_async. Everything that is read between two
+// deliveries on the JS thread is batched into a single callback invocation. With
+// framing enabled, every chunk is one complete record.
+//
+// The reader is created and destroyed on the JS thread. Use release() to stop a
+// running reader from any other thread.
+//
+// A reader created with a buffer size instead of a callback keeps the data in one
+// host ring buffer per channel instead, to be consumed with readBuffered(). It
+// has no uv handles and may be created and destroyed on any thread.
+//
+// A reader created with a capture file writes the data of one channel to the
+// file, and only passes statistics to the JS callback every statisticsInterval.
+//
+// A reader created with a shared ring writes the raw data of one channel into a
+// SharedArrayBuffer that JS reads from directly. The JS callback is only called
+// when the reader stops on an error.
+class RttReader
+{
+  public:
+    RttReader(const std::vector<uint32_t> & channels, const RttReaderOptions & options,
+              v8::Local<v8::Function> callback);
+    RttReader(const std::vector<uint32_t> & channels, const RttReaderOptions & options, uint32_t bufferSize);
+    RttReader(uint32_t channelIndex, const RttReaderOptions & options, std::unique_ptr<RttCaptureFile> capture,
+              v8::Local<v8::Function> callback);
+    RttReader(uint32_t channelIndex, const RttReaderOptions & options, std::unique_ptr<RttSharedRing> sharedRing,
+              v8::Local<v8::Function> callback);
+    ~RttReader();
+
+    // The recovery function is called on the lane after a read error, reading continues if it succeeds
+    void start(Probe_handle_t probe, std::chrono::high_resolution_clock::time_point startTime,
+               std::timed_mutex & laneMutex, rtt_recovery_function_t recover);
+    void stop();
+
+    Probe_handle_t getProbe() const;
+    rtt_reader_kind_t getKind() const;
+    bool isRunning() const;
+
+    // Opens the capture file, returns false if that failed
+    bool openCapture();
+
+    // The error that stopped a buffering reader, if any
+    nrfjprogdll_err_t getError();
+
+    // Returns false if the channel is not buffered by this reader
+    bool readBuffered(uint32_t channelIndex, char * data, uint32_t length, uint32_t & readLength);
+    std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> getBufferStatistics();
+
+    // Stops the reader and deletes it on the JS thread after remaining data is delivered
+    static void release(std::unique_ptr<RttReader> reader);
+
+  private:
+    void run();
+    nrfjprogdll_err_t poll(bool & receivedData);
+    // Splits the data read from a channel into records, and logs the bytes dropped to get back in sync
+    void frame(size_t channel, uint32_t readLength);
+    std::chrono::microseconds now() const;
+    void notify();
+    void storeStatistics();
+    void deliver();
+    void deliverStatistics();
+
+    static void onAsync(uv_async_t * handle);
+
+    const std::vector<uint32_t> channels;
+    const RttReaderOptions options;
+    const rtt_reader_kind_t kind;
+
+    Probe_handle_t probe;
+    std::chrono::high_resolution_clock::time_point startTime;
+    std::timed_mutex * laneMutex;
+    rtt_recovery_function_t recover;
+    // The trace track of the function that started the reader
+    uint32_t traceTrack;
+
+    // Receive times are taken from the monotonic clock, relative to startTime
+    std::chrono::microseconds startOffset;
+    std::chrono::steady_clock::time_point steadyStart;
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    AsyncRelease releasing;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    std::vector<char> readBuffer;
+    std::vector<std::unique_ptr<RttRingBuffer>> ringBuffers;
+    std::vector<RttFramer> framers;
+    std::vector<std::vector<char>> records;
+
+    std::unique_ptr<RttCaptureFile> capture;
+    bool captureFailed;
+    std::chrono::steady_clock::time_point lastStatistics;
+
+    std::unique_ptr<RttSharedRing> sharedRing;
+
+    std::mutex pendingMutex;
+    std::vector<RttChunk> pending;
+    nrfjprogdll_err_t pendingError;
+    bool pendingCaptureFailed;
+    bool statisticsDue;
+    RttCaptureStatistics pendingStatistics;
+};
+
+#endif // RTT_READER_H
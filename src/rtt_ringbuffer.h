@@ -0,0 +1,232 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_RINGBUFFER_H
+#define RTT_RINGBUFFER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Host side buffer for one RTT up channel. There is one producer (the reader
+// thread) and one consumer at a time (calls are serialized on the session
+// lane), so the data path is lock free. The arrival times used for the read
+// latency are kept in a second single producer ring of the same kind. Data that
+// does not fit is dropped and counted, the target is never stalled.
+class RttRingBuffer
+{
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    struct Statistics
+    {
+        uint32_t capacity;
+        uint32_t used;
+        uint32_t highWaterMark;
+        uint64_t bytesReceived;
+        uint64_t bytesDropped;
+        uint64_t bytesRead;
+        std::chrono::microseconds lastReadLatency;
+        std::chrono::microseconds maxReadLatency;
+    };
+
+    explicit RttRingBuffer(const uint32_t _capacity)
+        : buffer(_capacity)
+        , head(0)
+        , tail(0)
+        , bytesReceived(0)
+        , bytesDropped(0)
+        , highWaterMark(0)
+        , arrivalHead(0)
+        , arrivalTail(0)
+        , lastReadLatency(0)
+        , maxReadLatency(0)
+    {}
+
+    // Producer side. Returns the number of bytes stored.
+    uint32_t write(const char * data, const uint32_t length, const time_point now)
+    {
+        const auto currentHead = head.load(std::memory_order_relaxed);
+        const auto used        = static_cast<uint32_t>(currentHead - tail.load(std::memory_order_acquire));
+        const auto stored      = std::min(length, capacity() - used);
+
+        copyIn(currentHead, data, stored);
+
+        // The arrival is published before the data, so a read always finds the arrival of its oldest byte
+        if (stored > 0)
+        {
+            recordArrival(currentHead + stored, now);
+        }
+
+        head.store(currentHead + stored, std::memory_order_release);
+
+        bytesReceived += length;
+        bytesDropped += length - stored;
+
+        auto mark = highWaterMark.load(std::memory_order_relaxed);
+        while (used + stored > mark && !highWaterMark.compare_exchange_weak(mark, used + stored))
+        {
+        }
+
+        return stored;
+    }
+
+    // Consumer side. Returns the number of bytes read.
+    uint32_t read(char * data, const uint32_t length, const time_point now)
+    {
+        const auto currentTail = tail.load(std::memory_order_relaxed);
+        const auto available   = static_cast<uint32_t>(head.load(std::memory_order_acquire) - currentTail);
+        const auto count       = std::min(length, available);
+
+        copyOut(currentTail, data, count);
+        tail.store(currentTail + count, std::memory_order_release);
+
+        if (count > 0)
+        {
+            consumeArrivals(currentTail + count, now);
+        }
+
+        return count;
+    }
+
+    Statistics getStatistics()
+    {
+        Statistics statistics{};
+        statistics.capacity      = capacity();
+        statistics.used          = static_cast<uint32_t>(head.load() - tail.load());
+        statistics.highWaterMark = highWaterMark.load();
+        statistics.bytesReceived = bytesReceived.load();
+        statistics.bytesDropped  = bytesDropped.load();
+        statistics.bytesRead     = tail.load();
+
+        statistics.lastReadLatency = std::chrono::microseconds(lastReadLatency.load());
+        statistics.maxReadLatency  = std::chrono::microseconds(maxReadLatency.load());
+
+        return statistics;
+    }
+
+    uint32_t capacity() const
+    {
+        return static_cast<uint32_t>(buffer.size());
+    }
+
+  private:
+    static const size_t ARRIVAL_CAPACITY = 256;
+
+    struct Arrival
+    {
+        uint64_t end; // The head after the write
+        time_point time;
+    };
+
+    void recordArrival(const uint64_t end, const time_point now)
+    {
+        const auto currentHead = arrivalHead.load(std::memory_order_relaxed);
+
+        // With no room, the bytes are counted as arriving with the next write that is recorded
+        if (currentHead - arrivalTail.load(std::memory_order_acquire) < ARRIVAL_CAPACITY)
+        {
+            arrivals[currentHead % ARRIVAL_CAPACITY] = Arrival{end, now};
+            arrivalHead.store(currentHead + 1, std::memory_order_release);
+        }
+    }
+
+    void consumeArrivals(const uint64_t end, const time_point now)
+    {
+        auto currentTail       = arrivalTail.load(std::memory_order_relaxed);
+        const auto currentHead = arrivalHead.load(std::memory_order_acquire);
+
+        // The latency is measured from when the oldest byte of this read arrived
+        if (currentTail != currentHead)
+        {
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                                     now - arrivals[currentTail % ARRIVAL_CAPACITY].time)
+                                     .count();
+            lastReadLatency.store(latency);
+            maxReadLatency.store(std::max(maxReadLatency.load(std::memory_order_relaxed), latency));
+        }
+
+        while (currentTail != currentHead && arrivals[currentTail % ARRIVAL_CAPACITY].end <= end)
+        {
+            ++currentTail;
+        }
+
+        arrivalTail.store(currentTail, std::memory_order_release);
+    }
+
+    void copyIn(const uint64_t position, const char * data, const uint32_t length)
+    {
+        const auto offset = static_cast<uint32_t>(position % capacity());
+        const auto first  = std::min(length, capacity() - offset);
+
+        std::memcpy(buffer.data() + offset, data, first);
+        std::memcpy(buffer.data(), data + first, length - first);
+    }
+
+    void copyOut(const uint64_t position, char * data, const uint32_t length) const
+    {
+        const auto offset = static_cast<uint32_t>(position % capacity());
+        const auto first  = std::min(length, capacity() - offset);
+
+        std::memcpy(data, buffer.data() + offset, first);
+        std::memcpy(data + first, buffer.data(), length - first);
+    }
+
+    std::vector<char> buffer;
+
+    // Total number of bytes written and read, the difference is the fill level
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+
+    std::atomic<uint64_t> bytesReceived;
+    std::atomic<uint64_t> bytesDropped;
+    std::atomic<uint32_t> highWaterMark;
+
+    // Written by the producer between arrivalTail and arrivalHead, and only read by the consumer
+    std::array<Arrival, ARRIVAL_CAPACITY> arrivals;
+    std::atomic<uint64_t> arrivalHead;
+    std::atomic<uint64_t> arrivalTail;
+
+    // In microseconds, only written by the consumer
+    std::atomic<int64_t> lastReadLatency;
+    std::atomic<int64_t> maxReadLatency;
+};
+
+#endif // RTT_RINGBUFFER_H
@@ -0,0 +1,435 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_session.h"
+
+#include "dll_call.h"
+
+RttSession::RttSession(const uint32_t _serialNumber, Probe_handle_t _probe)
+    : serialNumber(_serialNumber)
+    , probe(_probe)
+    , startTime(std::chrono::high_resolution_clock::now())
+{}
+
+RttSession::~RttSession()
+{
+    releaseReader();
+    releaseWriter();
+}
+
+uint32_t RttSession::getSerialNumber() const
+{
+    return serialNumber;
+}
+
+Probe_handle_t RttSession::getProbe() const
+{
+    return probe;
+}
+
+std::chrono::high_resolution_clock::time_point RttSession::getStartTime() const
+{
+    return startTime;
+}
+
+void RttSession::setChannelInfo(const std::vector<std::unique_ptr<ChannelInfo>> & up,
+                                const std::vector<std::unique_ptr<ChannelInfo>> & down)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    upChannelInfo.clear();
+    downChannelInfo.clear();
+
+    for (const auto & element : up)
+    {
+        upChannelInfo.push_back(*element);
+    }
+
+    for (const auto & element : down)
+    {
+        downChannelInfo.push_back(*element);
+    }
+}
+
+size_t RttSession::getUpChannelCount()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    return upChannelInfo.size();
+}
+
+size_t RttSession::getDownChannelCount()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    return downChannelInfo.size();
+}
+
+nrfjprogdll_err_t RttSession::startReader(std::unique_ptr<RttReader> & _reader)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    if (reader)
+    {
+        if (reader->isRunning())
+        {
+            return INVALID_OPERATION; // Already subscribed
+        }
+
+        // The previous reader stopped on a read error, replace it
+        RttReader::release(std::move(reader));
+    }
+
+    _reader->start(probe, startTime, laneMutex, [this](nrfjprogdll_err_t error) { return recover(error); });
+    reader = std::move(_reader);
+
+    return SUCCESS;
+}
+
+void RttSession::releaseReader()
+{
+    std::unique_ptr<RttReader> released;
+
+    // The reader thread may be recovering, which needs the state lock, so it is joined without it
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        released = std::move(reader);
+    }
+
+    if (released)
+    {
+        RttReader::release(std::move(released));
+    }
+}
+
+nrfjprogdll_err_t RttSession::releaseReader(const rtt_reader_kind_t kind)
+{
+    std::unique_ptr<RttReader> released;
+
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+
+        if (reader && reader->getKind() != kind)
+        {
+            return INVALID_OPERATION;
+        }
+
+        released = std::move(reader);
+    }
+
+    if (released)
+    {
+        RttReader::release(std::move(released));
+    }
+
+    return SUCCESS;
+}
+
+bool RttSession::readBuffered(const uint32_t channelIndex, char * data, const uint32_t length,
+                              uint32_t & readLength, nrfjprogdll_err_t & status)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    if (!reader || !reader->readBuffered(channelIndex, data, length, readLength))
+    {
+        return false;
+    }
+
+    // Report why the buffer stopped filling once everything before it is consumed
+    status = readLength == 0 ? reader->getError() : SUCCESS;
+    return true;
+}
+
+bool RttSession::getBufferStatistics(std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> & statistics)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    if (!reader)
+    {
+        return false;
+    }
+
+    statistics = reader->getBufferStatistics();
+    return !statistics.empty();
+}
+
+nrfjprogdll_err_t RttSession::startWriter(std::unique_ptr<RttWriter> & _writer)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    if (writer)
+    {
+        if (writer->isRunning())
+        {
+            return INVALID_OPERATION; // Already opened
+        }
+
+        // The previous writer stopped on a write error, replace it
+        RttWriter::release(std::move(writer));
+    }
+
+    _writer->start(probe, laneMutex, [this](nrfjprogdll_err_t error) { return recover(error); });
+    writer = std::move(_writer);
+
+    return SUCCESS;
+}
+
+void RttSession::releaseWriter()
+{
+    std::unique_ptr<RttWriter> released;
+
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        released = std::move(writer);
+    }
+
+    if (released)
+    {
+        RttWriter::release(std::move(released));
+    }
+}
+
+bool RttSession::queueWrite(const uint32_t channelIndex, std::vector<char> data, bool & belowHighWaterMark,
+                            uint32_t & queuedLength)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    if (!writer || !writer->isRunning())
+    {
+        return false;
+    }
+
+    belowHighWaterMark = writer->queue(channelIndex, std::move(data), queuedLength);
+    return true;
+}
+
+void RttSession::enableRecovery(const bool hasControlBlockAddress, const uint32_t controlBlockAddress,
+                                const ControlBlockSearchOptions & options)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    recoveryOptions                           = options;
+    recoveryStatistics.enabled                = true;
+    recoveryStatistics.hasControlBlockAddress = hasControlBlockAddress;
+    recoveryStatistics.controlBlockAddress    = controlBlockAddress;
+}
+
+nrfjprogdll_err_t RttSession::recover(const nrfjprogdll_err_t error)
+{
+    bool hasAddress;
+    uint32_t address;
+    ControlBlockSearchOptions options;
+    uint32_t interrupts;
+
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+
+        if (!recoveryStatistics.enabled || recoveryStopped)
+        {
+            return error;
+        }
+
+        hasAddress = recoveryStatistics.hasControlBlockAddress;
+        address    = recoveryStatistics.controlBlockAddress;
+        options    = recoveryOptions;
+        interrupts = recoveryInterrupts;
+    }
+
+    const auto failedTime = std::chrono::steady_clock::now();
+
+    auto status = rearm(hasAddress, address, options, interrupts);
+
+    // The firmware after the reset may have another channel layout
+    if (status == SUCCESS)
+    {
+        status = readChannelInfo();
+    }
+
+    const auto downtime =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - failedTime);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    recoveryStatistics.lastError = error;
+
+    if (status != SUCCESS)
+    {
+        ++recoveryStatistics.failedRecoveries;
+        return error;
+    }
+
+    ++recoveryStatistics.reconnects;
+    recoveryStatistics.downtime += downtime;
+    recoveryStatistics.lastDowntime = downtime;
+
+    return SUCCESS;
+}
+
+RttRecoveryStatistics RttSession::getRecoveryStatistics()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    return recoveryStatistics;
+}
+
+void RttSession::interruptRecovery()
+{
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        ++recoveryInterrupts;
+    }
+
+    recoveryCondition.notify_all();
+}
+
+void RttSession::stopRecovery()
+{
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        recoveryStopped = true;
+    }
+
+    recoveryCondition.notify_all();
+}
+
+nrfjprogdll_err_t RttSession::rearm(const bool hasAddress, const uint32_t address,
+                                    const ControlBlockSearchOptions & options, const uint32_t interrupts)
+{
+    bool started = false;
+    DLL_CALL(NRFJPROG_is_rtt_started, probe, &started);
+
+    // Stopping may fail after the reset, what matters is that RTT can be started again
+    if (started)
+    {
+        DLL_CALL(NRFJPROG_rtt_stop, probe);
+    }
+
+    if (hasAddress)
+    {
+        const auto status = DLL_CALL(NRFJPROG_rtt_set_control_block_address, probe, address);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    const auto startStatus = DLL_CALL(NRFJPROG_rtt_start, probe);
+
+    if (startStatus != SUCCESS)
+    {
+        return startStatus;
+    }
+
+    const auto searchStart = std::chrono::steady_clock::now();
+    auto interval          = options.initialInterval;
+
+    // The control block is only valid again when the new firmware has initialized it
+    while (true)
+    {
+        auto found = false;
+
+        const auto status = DLL_CALL(NRFJPROG_rtt_is_control_block_found, probe, &found);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+
+        if (found)
+        {
+            return SUCCESS;
+        }
+
+        if (std::chrono::steady_clock::now() - searchStart >= options.timeout)
+        {
+            return TIME_OUT;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+
+        const auto interrupted = recoveryCondition.wait_for(
+            lock, interval, [&]() { return recoveryStopped || recoveryInterrupts != interrupts; });
+
+        if (interrupted)
+        {
+            return TIME_OUT;
+        }
+
+        interval = std::min(interval * 2, options.maxInterval);
+    }
+}
+
+nrfjprogdll_err_t RttSession::readChannelInfo()
+{
+    uint32_t downChannelNumber;
+    uint32_t upChannelNumber;
+
+    const auto countStatus = DLL_CALL(NRFJPROG_rtt_read_channel_count, probe, &downChannelNumber, &upChannelNumber);
+
+    if (countStatus != SUCCESS)
+    {
+        return countStatus;
+    }
+
+    std::vector<std::unique_ptr<ChannelInfo>> up;
+    std::vector<std::unique_ptr<ChannelInfo>> down;
+
+    for (const auto direction : {DOWN_DIRECTION, UP_DIRECTION})
+    {
+        const auto count   = direction == DOWN_DIRECTION ? downChannelNumber : upChannelNumber;
+        auto & channelInfo = direction == DOWN_DIRECTION ? down : up;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            char channelName[32];
+            auto * pChannelName = static_cast<char *>(channelName);
+            uint32_t channelSize;
+
+            const auto status =
+                DLL_CALL(NRFJPROG_rtt_read_channel_info, probe, i, direction, pChannelName, 32, &channelSize);
+
+            if (status != SUCCESS)
+            {
+                return status;
+            }
+
+            std::string name(pChannelName);
+            channelInfo.emplace_back(std::make_unique<ChannelInfo>(i, direction, name, channelSize));
+        }
+    }
+
+    setChannelInfo(up, down);
+
+    return SUCCESS;
+}
@@ -0,0 +1,143 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_SESSION_H
+#define RTT_SESSION_H
+
+#include "highlevel_common.h"
+#include "highlevel_helpers.h"
+#include "rtt_reader.h"
+#include "rtt_writer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct RttRecoveryStatistics
+{
+    bool enabled{false};
+    bool hasControlBlockAddress{false};
+    uint32_t controlBlockAddress{0};
+    uint32_t reconnects{0};
+    uint32_t failedRecoveries{0};
+    std::chrono::microseconds downtime{0}; // Summed over all reconnects
+    std::chrono::microseconds lastDowntime{0};
+    nrfjprogdll_err_t lastError{SUCCESS}; // The error that started the last recovery
+};
+
+// The state of RTT on one probe, from rttStart until rttStop. Every session has
+// its own execution lane, so RTT on one probe never waits for another probe.
+// The background reader and writer of the session also run on this lane.
+class RttSession
+{
+  public:
+    RttSession(uint32_t serialNumber, Probe_handle_t probe);
+    ~RttSession();
+
+    uint32_t getSerialNumber() const;
+    Probe_handle_t getProbe() const;
+    std::chrono::high_resolution_clock::time_point getStartTime() const;
+
+    void setChannelInfo(const std::vector<std::unique_ptr<ChannelInfo>> & up,
+                        const std::vector<std::unique_ptr<ChannelInfo>> & down);
+    size_t getUpChannelCount();
+    size_t getDownChannelCount();
+
+    // Returns INVALID_OPERATION if a reader is already running
+    nrfjprogdll_err_t startReader(std::unique_ptr<RttReader> & reader);
+    void releaseReader();
+    // Returns INVALID_OPERATION if the running reader is of another kind, and leaves it running
+    nrfjprogdll_err_t releaseReader(rtt_reader_kind_t kind);
+
+    // Returns false if the channel is not buffered on the host, the caller then reads from the device
+    bool readBuffered(uint32_t channelIndex, char * data, uint32_t length, uint32_t & readLength,
+                      nrfjprogdll_err_t & status);
+    bool getBufferStatistics(std::vector<std::pair<uint32_t, RttRingBuffer::Statistics>> & statistics);
+
+    // Returns INVALID_OPERATION if a writer is already running
+    nrfjprogdll_err_t startWriter(std::unique_ptr<RttWriter> & writer);
+    void releaseWriter();
+
+    // Returns false if there is no running write queue
+    bool queueWrite(uint32_t channelIndex, std::vector<char> data, bool & belowHighWaterMark,
+                    uint32_t & queuedLength);
+
+    // After a read or write error, RTT is stopped and re-armed at the cached control block
+    // address, or with a new search if the address is not known
+    void enableRecovery(bool hasControlBlockAddress, uint32_t controlBlockAddress,
+                        const ControlBlockSearchOptions & options);
+
+    // Must be called on the lane. Returns SUCCESS if RTT was re-armed, otherwise the original error.
+    nrfjprogdll_err_t recover(nrfjprogdll_err_t error);
+    RttRecoveryStatistics getRecoveryStatistics();
+
+    // A recovery holds the lane while it waits for the control block. These make it give up
+    // waiting, so a function that releases a reader or stops RTT gets the lane. After
+    // stopRecovery() the session does not recover again. May be called from any thread.
+    void interruptRecovery();
+    void stopRecovery();
+
+    // Held while a function runs on the probe of this session
+    std::timed_mutex laneMutex;
+
+  private:
+    nrfjprogdll_err_t rearm(bool hasAddress, uint32_t address, const ControlBlockSearchOptions & options,
+                            uint32_t interrupts);
+    nrfjprogdll_err_t readChannelInfo();
+
+    const uint32_t serialNumber;
+    const Probe_handle_t probe;
+    const std::chrono::high_resolution_clock::time_point startTime;
+
+    std::mutex stateMutex;
+    std::vector<ChannelInfo> upChannelInfo;
+    std::vector<ChannelInfo> downChannelInfo;
+    std::unique_ptr<RttReader> reader;
+    std::unique_ptr<RttWriter> writer;
+
+    ControlBlockSearchOptions recoveryOptions;
+    RttRecoveryStatistics recoveryStatistics;
+
+    // Waited on with the state mutex
+    std::condition_variable recoveryCondition;
+    uint32_t recoveryInterrupts{0};
+    bool recoveryStopped{false};
+};
+
+#endif // RTT_SESSION_H
@@ -0,0 +1,99 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_sharedring.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The header words are shared with JS Atomics, which needs them to be plain 32 bit integers
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> must have no overhead");
+
+RttSharedRing::RttSharedRing(v8::Local<v8::SharedArrayBuffer> _buffer)
+{
+    const auto headerLength = static_cast<uint32_t>(RTT_SHARED_RING_HEADER_WORDS * sizeof(uint32_t));
+
+#if V8_MAJOR_VERSION >= 8
+    // The backing store keeps the memory alive for the reader thread, whatever happens to the JS object
+    backingStore = _buffer->GetBackingStore();
+    header       = static_cast<uint8_t *>(backingStore->Data());
+#else
+    buffer.Reset(_buffer);
+    header = static_cast<uint8_t *>(_buffer->GetContents().Data());
+#endif
+
+    ring     = header + headerLength;
+    capacity = static_cast<uint32_t>(_buffer->ByteLength()) - headerLength;
+
+    word(RTT_SHARED_RING_WRITE_INDEX).store(0);
+    word(RTT_SHARED_RING_READ_INDEX).store(0);
+    word(RTT_SHARED_RING_DROPPED).store(0);
+    word(RTT_SHARED_RING_STATE).store(RTT_SHARED_RING_RUNNING);
+}
+
+void RttSharedRing::write(const char * data, const uint32_t length)
+{
+    const auto writeIndex = word(RTT_SHARED_RING_WRITE_INDEX).load(std::memory_order_relaxed);
+    const auto readIndex  = word(RTT_SHARED_RING_READ_INDEX).load(std::memory_order_acquire);
+
+    // A read index ahead of the write index can only come from a broken consumer, treat the ring as full
+    const auto used      = writeIndex - readIndex;
+    const auto available = used <= capacity ? capacity - used : 0;
+    const auto accepted  = std::min(length, available);
+
+    if (accepted < length)
+    {
+        word(RTT_SHARED_RING_DROPPED).fetch_add(length - accepted, std::memory_order_relaxed);
+    }
+
+    const auto offset     = writeIndex % capacity;
+    const auto firstWrite = std::min(accepted, capacity - offset);
+
+    std::memcpy(ring + offset, data, firstWrite);
+    std::memcpy(ring, data + firstWrite, accepted - firstWrite);
+
+    word(RTT_SHARED_RING_WRITE_INDEX).store(writeIndex + accepted, std::memory_order_release);
+}
+
+void RttSharedRing::setState(const rtt_shared_ring_state_t state)
+{
+    word(RTT_SHARED_RING_STATE).store(state, std::memory_order_release);
+}
+
+std::atomic<uint32_t> & RttSharedRing::word(const rtt_shared_ring_word_t index)
+{
+    return *reinterpret_cast<std::atomic<uint32_t> *>(header + index * sizeof(uint32_t));
+}
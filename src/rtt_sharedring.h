@@ -0,0 +1,75 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_SHAREDRING_H
+#define RTT_SHAREDRING_H
+
+#include "highlevel_common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Writes the data of one RTT up channel into a ring in a SharedArrayBuffer owned
+// by JS. The buffer starts with RTT_SHARED_RING_HEADER_WORDS 32 bit words, the
+// rest is the ring. The write index is only written here and the read index only
+// by JS. Both count bytes since the start and wrap at 2^32, so the ring holds
+// writeIndex - readIndex bytes. The write index is published after the data it
+// covers, so JS can read up to it with Atomics.load and no locking. Data that
+// does not fit is dropped and counted.
+class RttSharedRing
+{
+  public:
+    // The buffer must be longer than the header, must be called on the JS thread
+    explicit RttSharedRing(v8::Local<v8::SharedArrayBuffer> buffer);
+
+    void write(const char * data, uint32_t length);
+    void setState(rtt_shared_ring_state_t state);
+
+  private:
+    std::atomic<uint32_t> & word(rtt_shared_ring_word_t index);
+
+#if V8_MAJOR_VERSION >= 8
+    std::shared_ptr<v8::BackingStore> backingStore;
+#else
+    Nan::Global<v8::SharedArrayBuffer> buffer;
+#endif
+    uint8_t * header;
+    uint8_t * ring;
+    uint32_t capacity;
+};
+
+#endif // RTT_SHAREDRING_H
@@ -0,0 +1,387 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rtt_writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dll_call.h"
+#include "utility/conversion.h"
+#include "utility/errormessage.h"
+
+// Upper bound on consecutive writes to one channel in a single pass, so that a
+// busy channel cannot starve the other channels or the session lane.
+constexpr int MAX_WRITES_PER_PASS = 16;
+
+RttWriter::RttWriter(const RttWriterOptions & _options, v8::Local<v8::Function> _callback)
+    : options(_options)
+    , probe(nullptr)
+    , laneMutex(nullptr)
+    , callback(std::make_unique<Nan::Callback>(_callback))
+    , asyncHandle(new uv_async_t())
+    , running(false)
+    , writeBuffer(_options.maxWriteLength)
+    , pendingError(SUCCESS)
+{
+    uv_async_init(uv_default_loop(), asyncHandle, onAsync);
+    asyncHandle->data = static_cast<void *>(this);
+}
+
+RttWriter::~RttWriter()
+{
+    stop();
+
+    asyncHandle->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(asyncHandle),
+             [](uv_handle_t * handle) { delete reinterpret_cast<uv_async_t *>(handle); });
+}
+
+void RttWriter::start(Probe_handle_t _probe, std::timed_mutex & _laneMutex, rtt_recovery_function_t _recover)
+{
+    probe      = _probe;
+    laneMutex  = &_laneMutex;
+    recover    = std::move(_recover);
+    traceTrack = OperationTrace::currentTrack();
+    running    = true;
+    thread     = std::thread(&RttWriter::run, this);
+}
+
+void RttWriter::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        running = false;
+    }
+
+    wakeCondition.notify_all();
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+Probe_handle_t RttWriter::getProbe() const
+{
+    return probe;
+}
+
+bool RttWriter::isRunning() const
+{
+    return running;
+}
+
+bool RttWriter::queue(const uint32_t channelIndex, std::vector<char> data, uint32_t & queuedLength)
+{
+    bool belowHighWaterMark;
+
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+
+        auto & channelQueue = queues[channelIndex];
+        channelQueue.length += static_cast<uint32_t>(data.size());
+
+        if (!data.empty())
+        {
+            channelQueue.chunks.push_back(std::move(data));
+        }
+
+        belowHighWaterMark = channelQueue.length <= options.highWaterMark;
+        channelQueue.aboveHighWaterMark |= !belowHighWaterMark;
+        queuedLength = channelQueue.length;
+    }
+
+    wakeCondition.notify_all();
+
+    return belowHighWaterMark;
+}
+
+void RttWriter::release(std::unique_ptr<RttWriter> writer)
+{
+    writer->stop();
+
+    // The writer is deleted by onAsync from here on
+    auto handle = writer->asyncHandle;
+    writer.release()->releasing.request(handle);
+}
+
+void RttWriter::run()
+{
+    OperationTrace::TrackScope trackScope(traceTrack);
+
+    auto interval = options.minRetryInterval;
+
+    while (running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            wakeCondition.wait(lock, [this] { return !running || hasQueuedData(); });
+        }
+
+        auto targetFull = false;
+        auto status     = SUCCESS;
+
+        {
+            std::unique_lock<std::timed_mutex> lock(*laneMutex, std::defer_lock);
+
+            if (lock.try_lock_for(options.maxRetryInterval))
+            {
+                status = flush(targetFull);
+
+                // Data that was not written stays queued for the re-armed control block
+                if (status != SUCCESS && recover)
+                {
+                    status = recover(status);
+                }
+            }
+        }
+
+        if (status != SUCCESS)
+        {
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                pendingError = status;
+            }
+
+            running = false;
+            uv_async_send(asyncHandle);
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            if (!drained.empty())
+            {
+                uv_async_send(asyncHandle);
+            }
+        }
+
+        if (!targetFull)
+        {
+            interval = options.minRetryInterval;
+            continue;
+        }
+
+        // The target has not read its buffer yet, back off until it has room again
+        std::unique_lock<std::mutex> lock(queueMutex);
+        wakeCondition.wait_for(lock, interval, [this] { return !running; });
+        interval = std::min(interval * 2, options.maxRetryInterval);
+    }
+}
+
+nrfjprogdll_err_t RttWriter::flush(bool & targetFull)
+{
+    std::vector<uint32_t> channels;
+
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        for (const auto & channelQueue : queues)
+        {
+            if (channelQueue.second.length > 0)
+            {
+                channels.push_back(channelQueue.first);
+            }
+        }
+    }
+
+    for (const auto channelIndex : channels)
+    {
+        const auto status = flushChannel(channelIndex, targetFull);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return SUCCESS;
+}
+
+nrfjprogdll_err_t RttWriter::flushChannel(const uint32_t channelIndex, bool & targetFull)
+{
+    for (auto i = 0; i < MAX_WRITES_PER_PASS; ++i)
+    {
+        uint32_t length;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            length = coalesce(queues[channelIndex]);
+        }
+
+        if (length == 0)
+        {
+            break;
+        }
+
+        uint32_t writeLength = 0;
+
+        const auto status = DLL_TRANSFER(THROUGHPUT_RTT_DOWN,
+                                         writeLength,
+                                         NRFJPROG_rtt_write,
+                                         probe,
+                                         channelIndex,
+                                         writeBuffer.data(),
+                                         length,
+                                         &writeLength);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            consume(channelIndex, queues[channelIndex], writeLength);
+        }
+
+        if (writeLength < length)
+        {
+            targetFull = true;
+            break;
+        }
+    }
+
+    return SUCCESS;
+}
+
+uint32_t RttWriter::coalesce(ChannelQueue & channelQueue)
+{
+    uint32_t length = 0;
+    auto offset     = channelQueue.frontOffset;
+
+    for (const auto & chunk : channelQueue.chunks)
+    {
+        const auto count = std::min(chunk.size() - offset, static_cast<size_t>(options.maxWriteLength - length));
+
+        std::memcpy(writeBuffer.data() + length, chunk.data() + offset, count);
+        length += static_cast<uint32_t>(count);
+        offset = 0;
+
+        if (length == options.maxWriteLength)
+        {
+            break;
+        }
+    }
+
+    return length;
+}
+
+void RttWriter::consume(const uint32_t channelIndex, ChannelQueue & channelQueue, uint32_t length)
+{
+    channelQueue.length -= length;
+
+    while (length > 0)
+    {
+        const auto count = std::min(channelQueue.chunks.front().size() - channelQueue.frontOffset,
+                                    static_cast<size_t>(length));
+
+        channelQueue.frontOffset += count;
+        length -= static_cast<uint32_t>(count);
+
+        if (channelQueue.frontOffset == channelQueue.chunks.front().size())
+        {
+            channelQueue.chunks.pop_front();
+            channelQueue.frontOffset = 0;
+        }
+    }
+
+    if (channelQueue.length == 0 && channelQueue.aboveHighWaterMark)
+    {
+        channelQueue.aboveHighWaterMark = false;
+        drained.push_back(channelIndex);
+    }
+}
+
+bool RttWriter::hasQueuedData() const
+{
+    return std::any_of(queues.begin(), queues.end(), [](const std::pair<const uint32_t, ChannelQueue> & v) {
+        return v.second.length > 0;
+    });
+}
+
+void RttWriter::deliver()
+{
+    std::vector<uint32_t> channels;
+    nrfjprogdll_err_t error;
+
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        channels.swap(drained);
+        error        = pendingError;
+        pendingError = SUCCESS;
+    }
+
+    Nan::HandleScope scope;
+    Nan::AsyncResource resource("pc-nrfjprog-js:rtt-write-queue");
+
+    for (const auto channelIndex : channels)
+    {
+        v8::Local<v8::Value> argv[2];
+        argv[0] = Nan::Undefined();
+        argv[1] = Convert::toJsNumber(channelIndex);
+
+        callback->Call(2, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+    }
+
+    if (error != SUCCESS)
+    {
+        v8::Local<v8::Value> argv[1];
+        argv[0] =
+            ErrorMessage::getErrorMessage(CouldNotCallFunction, nrfjprog_js_err_map, "rtt queued write", "", error);
+
+        callback->Call(1, static_cast<v8::Local<v8::Value> *>(argv), &resource);
+    }
+}
+
+void RttWriter::onAsync(uv_async_t * handle)
+{
+    auto writer = static_cast<RttWriter *>(handle->data);
+
+    if (writer == nullptr)
+    {
+        return;
+    }
+
+    const auto released = writer->releasing.isRequested();
+
+    writer->deliver();
+
+    if (released)
+    {
+        delete writer;
+    }
+}
@@ -0,0 +1,133 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTT_WRITER_H
+#define RTT_WRITER_H
+
+#include "async_release.h"
+#include "highlevel_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct RttWriterOptions
+{
+    uint32_t highWaterMark{65536};
+    uint32_t maxWriteLength{1024};
+    std::chrono::milliseconds minRetryInterval{1};
+    std::chrono::milliseconds maxRetryInterval{50};
+};
+
+// Queues data for RTT down channels and writes it on a background thread.
+// Small writes are coalesced into writes of up to maxWriteLength bytes, and
+// what the target does not accept is retried with a backoff while its buffer
+// is full. A channel queue that has grown above the high water mark is
+// reported to the JS callback through uv_async when it has drained.
+//
+// The writer is created and destroyed on the JS thread. Use release() to stop a
+// running writer from any other thread.
+class RttWriter
+{
+  public:
+    RttWriter(const RttWriterOptions & options, v8::Local<v8::Function> callback);
+    ~RttWriter();
+
+    // The recovery function is called on the lane after a write error, writing continues if it succeeds
+    void start(Probe_handle_t probe, std::timed_mutex & laneMutex, rtt_recovery_function_t recover);
+    void stop();
+
+    Probe_handle_t getProbe() const;
+    bool isRunning() const;
+
+    // Returns false if the channel queue is above the high water mark after adding the data
+    bool queue(uint32_t channelIndex, std::vector<char> data, uint32_t & queuedLength);
+
+    // Stops the writer and deletes it on the JS thread after pending events are delivered
+    static void release(std::unique_ptr<RttWriter> writer);
+
+  private:
+    struct ChannelQueue
+    {
+        std::deque<std::vector<char>> chunks;
+        size_t frontOffset{0};
+        uint32_t length{0};
+        bool aboveHighWaterMark{false};
+    };
+
+    void run();
+    nrfjprogdll_err_t flush(bool & targetFull);
+    nrfjprogdll_err_t flushChannel(uint32_t channelIndex, bool & targetFull);
+    uint32_t coalesce(ChannelQueue & channelQueue);
+    void consume(uint32_t channelIndex, ChannelQueue & channelQueue, uint32_t length);
+    bool hasQueuedData() const;
+    void deliver();
+
+    static void onAsync(uv_async_t * handle);
+
+    const RttWriterOptions options;
+
+    Probe_handle_t probe;
+    std::timed_mutex * laneMutex;
+    rtt_recovery_function_t recover;
+    // The trace track of the function that started the writer
+    uint32_t traceTrack;
+
+    std::unique_ptr<Nan::Callback> callback;
+    uv_async_t * asyncHandle;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    AsyncRelease releasing;
+
+    // Guards the queues and the pending events, and is used to wake the thread
+    std::mutex queueMutex;
+    std::condition_variable wakeCondition;
+    std::map<uint32_t, ChannelQueue> queues;
+
+    std::vector<char> writeBuffer;
+
+    std::vector<uint32_t> drained;
+    nrfjprogdll_err_t pendingError;
+};
+
+#endif // RTT_WRITER_H
@@ -0,0 +1,80 @@
+/* Copyright (c) 2015 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Use in source and binary forms, redistribution in binary form only, with
+ * or without modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 2. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 3. This software, with or without modification, must only be used with a Nordic
+ *    Semiconductor ASA integrated circuit.
+ *
+ * 4. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ * TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THROUGHPUT_COUNTERS_H
+#define THROUGHPUT_COUNTERS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+typedef enum {
+    THROUGHPUT_READ,
+    THROUGHPUT_WRITE,
+    THROUGHPUT_PROGRAM,
+    THROUGHPUT_VERIFY,
+    THROUGHPUT_RTT_UP,
+    THROUGHPUT_RTT_DOWN,
+    THROUGHPUT_DIRECTION_COUNT
+} throughput_direction_t;
+
+// The bytes moved to and from each probe, and the time the library calls moving them took.
+// The probe is the lane of the thread making the call, see OperationTrace::TrackScope.
+class ThroughputCounters
+{
+  public:
+    struct Counter
+    {
+        uint64_t bytes{0};
+        uint64_t transfers{0};
+        std::chrono::microseconds time{0};
+    };
+
+    using counters_t = std::array<Counter, THROUGHPUT_DIRECTION_COUNT>;
+
+    static void record(throughput_direction_t direction, uint64_t bytes, std::chrono::microseconds time);
+    static void reset();
+
+    static std::map<uint32_t, counters_t> get();
+
+  private:
+    static std::mutex mutex;
+    static std::map<uint32_t, counters_t> serialNumbers;
+};
+
+#endif // THROUGHPUT_COUNTERS_H
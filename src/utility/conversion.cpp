@@ -251,6 +251,32 @@ std::vector<uint8_t> Convert::getVectorForUint8(v8::Local<v8::Value> js)
     return returnData;
 }
 
+std::vector<uint32_t> Convert::getVectorForUint32(v8::Local<v8::Object> js, const char * name)
+{
+    v8::Local<v8::Value> value = Utility::Get(js, name);
+
+    RETURN_VALUE_OR_THROW_EXCEPTION(Convert::getVectorForUint32(value));
+}
+
+std::vector<uint32_t> Convert::getVectorForUint32(v8::Local<v8::Value> js)
+{
+    if (!js->IsArray())
+    {
+        throw std::runtime_error("array");
+    }
+
+    v8::Local<v8::Array> jsarray = v8::Local<v8::Array>::Cast(js);
+    auto length                  = jsarray->Length();
+    std::vector<uint32_t> returnData;
+
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        returnData.push_back(Convert::getNativeUint32(Nan::Get(jsarray, i).ToLocalChecked()));
+    }
+
+    return returnData;
+}
+
 uint32_t Convert::getLengthOfArray(v8::Local<v8::Object> js, const char * name)
 {
     v8::Local<v8::Value> value = Utility::Get(js, name);
@@ -390,6 +416,12 @@ v8::Handle<v8::Value> Convert::toJsValueArray(uint8_t * nativeValue, uint32_t le
     return scope.Escape(valueArray);
 }
 
+v8::Handle<v8::Value> Convert::toJsBuffer(const char * nativeValue, uint32_t length)
+{
+    Nan::EscapableHandleScope scope;
+    return scope.Escape(Nan::CopyBuffer(nativeValue, length).ToLocalChecked());
+}
+
 v8::Handle<v8::Value> Convert::toJsString(const char * cString)
 {
     return Convert::toJsString(cString, strlen(cString));
@@ -66,6 +66,8 @@ class Convert
     static std::vector<char> getVectorForChar(v8::Local<v8::Value> js);
     static std::vector<uint8_t> getVectorForUint8(v8::Local<v8::Object> js, const char * name);
     static std::vector<uint8_t> getVectorForUint8(v8::Local<v8::Value> js);
+    static std::vector<uint32_t> getVectorForUint32(v8::Local<v8::Object> js, const char * name);
+    static std::vector<uint32_t> getVectorForUint32(v8::Local<v8::Value> js);
     static uint32_t getLengthOfArray(v8::Local<v8::Object> js, const char * name);
     static uint32_t getLengthOfArray(v8::Local<v8::Value> js);
     static v8::Local<v8::Object> getJsObject(v8::Local<v8::Object> js, const char * name);
@@ -85,6 +87,7 @@ class Convert
     static v8::Handle<v8::Value> toJsBool(uint8_t nativeValue);
     static v8::Handle<v8::Value> toJsBool(bool nativeValue);
     static v8::Handle<v8::Value> toJsValueArray(uint8_t * nativeValue, uint32_t length);
+    static v8::Handle<v8::Value> toJsBuffer(const char * nativeValue, uint32_t length);
     static v8::Handle<v8::Value> toJsString(const char * cString);
     static v8::Handle<v8::Value> toJsString(const char * cString, size_t length);
     static v8::Handle<v8::Value> toJsString(uint8_t * cString, size_t length);
@@ -37,6 +37,9 @@
 'use strict';
 
 const nRFjprog = require('../index.js');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
 
 jasmine.DEFAULT_TIMEOUT_INTERVAL = 100000;
 
@@ -79,6 +82,157 @@ const generic = () => {
         nRFjprog.getConnectedDevices(callback);
     });
 
+    it('reports how long reading each connected device took', done => {
+        const callback = (err, connectedDevices) => {
+            expect(err).toBeUndefined();
+            connectedDevices.forEach(connectedDevice => {
+                expect(connectedDevice.enumerationTime).toBeGreaterThan(0);
+                expect(connectedDevice.error).toBeUndefined();
+            });
+            done();
+        };
+
+        // Devices from the cache are not read at all
+        nRFjprog.invalidateDeviceInfo(err => {
+            expect(err).toBeUndefined();
+            nRFjprog.getConnectedDevices(callback);
+        });
+    });
+
+    it('discovers all connected devices one by one', done => {
+        const devices = [];
+
+        const deviceCallback = (err, device) => {
+            expect(err).toBeUndefined();
+            expect(device).toHaveProperty('serialNumber');
+            expect(device).toHaveProperty('enumerationTime');
+            devices.push(device);
+        };
+
+        const callback = (err, deviceCount) => {
+            expect(err).toBeUndefined();
+            expect(deviceCount).toBeGreaterThanOrEqual(1);
+            expect(devices.length).toBe(deviceCount);
+            done();
+        };
+
+        nRFjprog.discoverDevices(deviceCallback, callback);
+    });
+
+    it('serves connected devices from the cache until invalidated', done => {
+        const invalidatedCallback = (err, connectedDevices) => {
+            expect(err).toBeUndefined();
+            expect(connectedDevices[0].cached).toBe(false);
+            done();
+        };
+
+        const cachedCallback = (err, connectedDevices) => {
+            expect(err).toBeUndefined();
+            expect(connectedDevices[0].cached).toBe(true);
+            expect(connectedDevices[0].enumerationTime).toBe(0);
+
+            nRFjprog.invalidateDeviceInfo(invalidateErr => {
+                expect(invalidateErr).toBeUndefined();
+                nRFjprog.getConnectedDevices(invalidatedCallback);
+            });
+        };
+
+        nRFjprog.getConnectedDevices(err => {
+            expect(err).toBeUndefined();
+            nRFjprog.getConnectedDevices(cachedCallback);
+        });
+    });
+
+    it('only enumerates the invalidated device again', done => {
+        nRFjprog.getConnectedDevices((err, connectedDevices) => {
+            expect(err).toBeUndefined();
+
+            const { serialNumber } = connectedDevices[0];
+
+            nRFjprog.invalidateDeviceInfo(serialNumber, invalidateErr => {
+                expect(invalidateErr).toBeUndefined();
+
+                nRFjprog.getConnectedDevices((invalidatedErr, invalidatedDevices) => {
+                    expect(invalidatedErr).toBeUndefined();
+                    invalidatedDevices.forEach(device => {
+                        expect(device.cached).toBe(device.serialNumber !== serialNumber);
+                    });
+                    done();
+                });
+            });
+        });
+    });
+
+    it('reports simulated probes being attached and detached', done => {
+        const events = [];
+
+        const eventCallback = (err, event) => {
+            expect(err).toBeUndefined();
+            events.push(event);
+
+            if (event.type === 'attach') {
+                nRFjprog.setSimulatedProbes([], setErr => expect(setErr).toBeUndefined());
+            } else {
+                nRFjprog.stopProbeWatcher(stopErr => {
+                    expect(stopErr).toBeUndefined();
+
+                    // The probe that was only briefly attached is debounced
+                    expect(events).toEqual([
+                        { type: 'attach', serialNumber: 1234 },
+                        { type: 'detach', serialNumber: 1234 },
+                    ]);
+                    done();
+                });
+            }
+        };
+
+        const options = { pollInterval: 50, debounceTime: 200, simulated: true };
+
+        nRFjprog.startProbeWatcher(options, eventCallback, err => {
+            expect(err).toBeUndefined();
+            nRFjprog.setSimulatedProbes([1234, 5678], setErr => {
+                expect(setErr).toBeUndefined();
+                nRFjprog.setSimulatedProbes([1234], () => {});
+            });
+        });
+    });
+
+    it('fails to get the probe health unless the monitor is started', done => {
+        nRFjprog.getProbeHealth(err => {
+            expect(err).toBeDefined();
+            done();
+        });
+    });
+
+    it('monitors the health of probes', done => {
+        const eventCallback = err => expect(err).toBeUndefined();
+
+        nRFjprog.getSerialNumbers((err, serialNumbers) => {
+            expect(err).toBeUndefined();
+
+            const options = { interval: 100, serialNumbers: [serialNumbers[0]] };
+
+            nRFjprog.startHealthMonitor(options, eventCallback, startErr => {
+                expect(startErr).toBeUndefined();
+
+                setTimeout(() => {
+                    nRFjprog.getProbeHealth((healthErr, health) => {
+                        expect(healthErr).toBeUndefined();
+                        expect(health[0].serialNumber).toBe(serialNumbers[0]);
+                        expect(health[0].healthy).toBe(true);
+                        expect(health[0].checks).toBeGreaterThan(0);
+                        expect(health[0].lastLatency).toBeGreaterThan(0);
+
+                        nRFjprog.stopHealthMonitor(stopErr => {
+                            expect(stopErr).toBeUndefined();
+                            done();
+                        });
+                    });
+                }, 1000);
+            });
+        });
+    });
+
     it('finds all connected serialnumbers', done => {
         const callback = (err, serialNumbers) => {
             expect(err).toBeUndefined();
@@ -91,6 +245,287 @@ const generic = () => {
         nRFjprog.getSerialNumbers(callback);
     });
 
+    it('reads only probe information when asked to', done => {
+        const options = { fields: nRFjprog.ENUMERATE_PROBE_INFO };
+
+        nRFjprog.invalidateDeviceInfo(err => {
+            expect(err).toBeUndefined();
+            nRFjprog.getConnectedDevices(options, (connectedErr, connectedDevices) => {
+                expect(connectedErr).toBeUndefined();
+                connectedDevices.forEach(connectedDevice => {
+                    expect(connectedDevice).not.toHaveProperty('deviceInfo');
+                    expect(connectedDevice).toHaveProperty('probeInfo.firmwareString');
+                    expect(connectedDevice).toHaveProperty('libraryInfo');
+                });
+                done();
+            });
+        });
+    });
+
+    it('finds connected serialnumbers by prefix and range', done => {
+        nRFjprog.getSerialNumbers((err, serialNumbers) => {
+            expect(err).toBeUndefined();
+
+            const serialNumber = serialNumbers[0];
+            const prefix = String(serialNumber).substring(0, 3);
+
+            nRFjprog.getSerialNumbers({ serialNumberPrefix: prefix }, (prefixErr, prefixed) => {
+                expect(prefixErr).toBeUndefined();
+                expect(prefixed).toContain(serialNumber);
+                prefixed.forEach(s => expect(String(s).startsWith(prefix)).toBe(true));
+
+                const range = { minSerialNumber: serialNumber + 1, maxSerialNumber: serialNumber + 1 };
+                nRFjprog.getConnectedDevices(range, (rangeErr, devices) => {
+                    expect(rangeErr).toBeUndefined();
+                    expect(devices.map(device => device.serialNumber)).not.toContain(serialNumber);
+                    done();
+                });
+            });
+        });
+    });
+
+    it('calls back functions that do not use the library', done => {
+        nRFjprog.resetStats(resetErr => {
+            expect(resetErr).toBeUndefined();
+
+            nRFjprog.getStats((statsErr, stats) => {
+                expect(statsErr).toBeUndefined();
+                expect(stats).toHaveProperty('methods');
+                done();
+            });
+        });
+    });
+
+    it('reports the timing of each function', done => {
+        nRFjprog.resetStats(resetErr => {
+            expect(resetErr).toBeUndefined();
+
+            nRFjprog.setTimingEnabled(true, enableErr => {
+                expect(enableErr).toBeUndefined();
+
+                nRFjprog.getLibraryVersion((err, version, timing) => {
+                    expect(err).toBeUndefined();
+                    expect(timing.executions).toBe(1);
+                    expect(timing.total).toBeGreaterThanOrEqual(timing.operation);
+
+                    nRFjprog.getStats((statsErr, stats, statsTiming) => {
+                        expect(statsErr).toBeUndefined();
+                        expect(statsTiming).toBeDefined();
+                        expect(stats.methods['get library version'].count).toBe(1);
+                        expect(stats.methods['get library version'].errors).toBe(0);
+                        expect(stats.methods['get library version']).toHaveProperty('total.max');
+
+                        nRFjprog.setTimingEnabled(false, done);
+                    });
+                });
+            });
+        });
+    });
+
+    it('does not pass the timing unless it is enabled', done => {
+        nRFjprog.setTimingEnabled(true, enableErr => {
+            expect(enableErr).toBeUndefined();
+
+            nRFjprog.setTimingEnabled(false, disableErr => {
+                expect(disableErr).toBeUndefined();
+
+                nRFjprog.getLibraryVersion((...args) => {
+                    expect(args[0]).toBeUndefined();
+                    expect(args.length).toBe(2);
+                    done();
+                });
+            });
+        });
+    });
+
+    it('counts the calls into the library', done => {
+        nRFjprog.resetLibraryCallStats(resetErr => {
+            expect(resetErr).toBeUndefined();
+
+            nRFjprog.getLibraryVersion(err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.getLibraryCallStats((statsErr, stats) => {
+                    expect(statsErr).toBeUndefined();
+
+                    const versionCalls = stats.functions.NRFJPROG_dll_version;
+                    expect(versionCalls.count).toBe(1);
+                    expect(versionCalls.errors).toBe(0);
+                    expect(versionCalls.histogram.reduce((sum, count) => sum + count, 0)).toBe(1);
+                    done();
+                });
+            });
+        });
+    });
+
+    it('forgets the library calls when reset', done => {
+        nRFjprog.getLibraryVersion(err => {
+            expect(err).toBeUndefined();
+
+            nRFjprog.resetLibraryCallStats(resetErr => {
+                expect(resetErr).toBeUndefined();
+
+                nRFjprog.getLibraryCallStats((statsErr, stats) => {
+                    expect(statsErr).toBeUndefined();
+                    expect(stats.functions).toEqual({});
+                    expect(stats.serialNumbers).toEqual({});
+                    done();
+                });
+            });
+        });
+    });
+
+    it('forgets the transfers when the throughput is reset', done => {
+        nRFjprog.resetThroughputStats(resetErr => {
+            expect(resetErr).toBeUndefined();
+
+            nRFjprog.getThroughputStats((statsErr, stats) => {
+                expect(statsErr).toBeUndefined();
+                expect(stats).toEqual({});
+                done();
+            });
+        });
+    });
+
+    it('traces functions and the library calls they make', done => {
+        const traceFile = path.join(os.tmpdir(), 'pc-nrfjprog-js-trace.json');
+
+        nRFjprog.startTrace({ capacity: 1000 }, startErr => {
+            expect(startErr).toBeUndefined();
+
+            nRFjprog.getLibraryVersion(err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.stopTrace(stopErr => {
+                    expect(stopErr).toBeUndefined();
+
+                    nRFjprog.flushTrace(traceFile, (flushErr, eventCount) => {
+                        expect(flushErr).toBeUndefined();
+                        expect(eventCount).toBeGreaterThan(0);
+
+                        const trace = JSON.parse(fs.readFileSync(traceFile, 'utf8'));
+                        const names = trace.traceEvents.map(event => event.name);
+                        expect(names).toContain('parse get library version');
+                        expect(names).toContain('get library version');
+                        expect(names).toContain('NRFJPROG_dll_version');
+                        expect(names).toContain('thread_name');
+
+                        fs.unlinkSync(traceFile);
+                        done();
+                    });
+                });
+            });
+        });
+    });
+
+    it('flushes no events unless the trace is started', done => {
+        const traceFile = path.join(os.tmpdir(), 'pc-nrfjprog-js-empty-trace.json');
+
+        nRFjprog.stopTrace(stopErr => {
+            expect(stopErr).toBeUndefined();
+
+            nRFjprog.flushTrace(traceFile, flushErr => {
+                expect(flushErr).toBeUndefined();
+
+                nRFjprog.getLibraryVersion(err => {
+                    expect(err).toBeUndefined();
+
+                    nRFjprog.flushTrace(traceFile, (secondErr, eventCount) => {
+                        expect(secondErr).toBeUndefined();
+                        expect(eventCount).toBe(0);
+
+                        fs.unlinkSync(traceFile);
+                        done();
+                    });
+                });
+            });
+        });
+    });
+
+    it('only keeps log records at or above the log level', done => {
+        nRFjprog.getLog((err, before) => {
+            expect(err).toBeUndefined();
+
+            const since = before.length > 0 ? before[before.length - 1].sequence + 1 : 0;
+
+            nRFjprog.setLogLevel(nRFjprog.LOG_LEVEL_ERROR, setErr => {
+                expect(setErr).toBeUndefined();
+
+                nRFjprog.getSerialNumbers(serialErr => {
+                    expect(serialErr).toBeUndefined();
+
+                    nRFjprog.getLog({ since }, (logErr, records) => {
+                        expect(logErr).toBeUndefined();
+                        records.forEach(record => {
+                            expect(record.level).toBeGreaterThanOrEqual(nRFjprog.LOG_LEVEL_ERROR);
+                        });
+
+                        nRFjprog.setLogLevel(nRFjprog.LOG_LEVEL_DEBUG, done);
+                    });
+                });
+            });
+        });
+    });
+
+    it('keeps no log records when logging is turned off', done => {
+        nRFjprog.getLog((err, before) => {
+            expect(err).toBeUndefined();
+
+            const since = before.length > 0 ? before[before.length - 1].sequence + 1 : 0;
+
+            nRFjprog.setLogLevel(nRFjprog.LOG_LEVEL_NONE, setErr => {
+                expect(setErr).toBeUndefined();
+
+                nRFjprog.getSerialNumbers(serialErr => {
+                    expect(serialErr).toBeUndefined();
+
+                    nRFjprog.getLog({ since }, (logErr, records) => {
+                        expect(logErr).toBeUndefined();
+                        expect(records).toEqual([]);
+
+                        nRFjprog.setLogLevel(nRFjprog.LOG_LEVEL_DEBUG, done);
+                    });
+                });
+            });
+        });
+    });
+
+    it('unsubscribes from the log without a subscription', done => {
+        nRFjprog.unsubscribeLog(err => {
+            expect(err).toBeUndefined();
+            done();
+        });
+    });
+
+    it('passes log records on while they are added', done => {
+        const options = { level: nRFjprog.LOG_LEVEL_DEBUG, interval: 10 };
+        const recordsCallback = (err, records, dropped) => {
+            expect(err).toBeUndefined();
+            expect(dropped).toEqual(expect.any(Number));
+            records.forEach(record => {
+                expect(record.level).toBeGreaterThanOrEqual(nRFjprog.LOG_LEVEL_DEBUG);
+                expect(record.message).toEqual(expect.any(String));
+            });
+        };
+
+        nRFjprog.subscribeLog(options, recordsCallback, subscribeErr => {
+            expect(subscribeErr).toBeUndefined();
+
+            nRFjprog.subscribeLog(options, recordsCallback, secondErr => {
+                expect(secondErr).toBeDefined();
+
+                nRFjprog.getSerialNumbers(serialErr => {
+                    expect(serialErr).toBeUndefined();
+
+                    nRFjprog.unsubscribeLog(unsubscribeErr => {
+                        expect(unsubscribeErr).toBeUndefined();
+                        done();
+                    });
+                });
+            });
+        });
+    });
+
     it('throws when too few parameters are sent in', () => {
         expect(() => { nRFjprog.getLibraryVersion(); }).toThrowErrorMatchingSnapshot();
     });
@@ -37,6 +37,9 @@
 'use strict';
 
 const nRFjprog = require('../index.js');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
 
 let device;
 
@@ -101,6 +104,40 @@ const rtt = () => {
             nRFjprog.rttStart(device.serialNumber, { controlBlockLocation: 0x200006E0 }, startCallback);
         });
 
+        it('reports how long the control block search took', (done) => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            const startCallback = (err, down, up, searchTime) => {
+                expect(err).toBeUndefined();
+                expect(searchTime).toEqual(expect.any(Number));
+                expect(searchTime).toBeLessThan(1000 * 1000);
+
+                nRFjprog.rttStop(device.serialNumber, stopCallback);
+            };
+
+            nRFjprog.rttStart(device.serialNumber, { searchInitialInterval: 1, searchMaxInterval: 50, searchTimeout: 1000 }, startCallback);
+        });
+
+        it('attaches to the running firmware without reset', (done) => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(down).toBeDefined();
+                expect(up).toBeDefined();
+
+                nRFjprog.rttStop(device.serialNumber, stopCallback);
+            };
+
+            nRFjprog.rttStart(device.serialNumber, { reset: false, searchRangeStart: 0x20000000, searchRangeLength: 0x10000 }, startCallback);
+        });
+
         it('returns an error when wrong serialnumber', done => {
             const startCallback = (err, down, up) => {
                 expect(err).toBeDefined();
@@ -122,6 +159,17 @@ const rtt = () => {
 
             nRFjprog.rttStart(device.serialNumber, { controlBlockLocation: 15 }, startCallback);
         });
+
+        it('returns an error when the firmware image is not an ELF file', done => {
+            const startCallback = (err) => {
+                expect(err).toBeDefined();
+
+                done();
+            };
+
+            const elfPath = path.join(__dirname, 'hex', 'rtt.hex');
+            nRFjprog.rttStart(device.serialNumber, { elfPath }, startCallback);
+        });
     });
 
     describe('fails cleanly when calling other functions before start', () => {
@@ -203,6 +251,29 @@ const rtt = () => {
 
             nRFjprog.rttRead(device.serialNumber, 0, readLength, readCallback);
         });
+
+        it('reads several channels in one call', done => {
+            const readCallback = (err, buffers, time) => {
+                expect(err).toBeUndefined();
+                expect(buffers.length).toBe(2);
+                expect(buffers[0]).toBeInstanceOf(Buffer);
+                expect(buffers[0].length).toBeLessThanOrEqual(100);
+                expect(buffers[1].length).toBeLessThanOrEqual(10);
+                expect(time).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttReadMany(device.serialNumber, [{ channel: 0, maxLength: 100 }, { channel: 0, maxLength: 10 }], readCallback);
+        });
+
+        it('throws when the read lengths of rttReadMany add up to too much', () => {
+            const mockCallback = jest.fn();
+            const channels = [{ channel: 0, maxLength: 0xFFFFFFF0 }, { channel: 1, maxLength: 0x20 }];
+
+            expect(() => { nRFjprog.rttReadMany(device.serialNumber, channels, mockCallback); }).toThrow(TypeError);
+            expect(mockCallback).not.toHaveBeenCalled();
+        });
     });
 
     describe('writes to device', () => {
@@ -295,6 +366,414 @@ const rtt = () => {
         });
     });
 
+    describe('subscribes to device', () => {
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(down).toBeDefined();
+                expect(up).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, {}, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('receives the loopback data without polling', done => {
+            const writetext = "this is a test";
+            let received = '';
+
+            const dataCallback = (err, chunks) => {
+                expect(err).toBeUndefined();
+
+                chunks.forEach(chunk => {
+                    expect(chunk.channelIndex).toBe(0);
+                    expect(chunk.data).toBeInstanceOf(Buffer);
+                    expect(chunk.time).toBeDefined();
+                    received += chunk.data.toString();
+                });
+
+                if (received.endsWith(writetext)) {
+                    nRFjprog.rttUnsubscribe(device.serialNumber, err => {
+                        expect(err).toBeUndefined();
+                        done();
+                    });
+                }
+            };
+
+            const subscribeCallback = err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttWrite(device.serialNumber, 0, writetext, err => {
+                    expect(err).toBeUndefined();
+                });
+            };
+
+            nRFjprog.rttSubscribe(device.serialNumber, [0], {}, dataCallback, subscribeCallback);
+        });
+
+        it('leaves a subscription running when another kind of reader is stopped', done => {
+            const dataCallback = err => expect(err).toBeUndefined();
+
+            nRFjprog.rttSubscribe(device.serialNumber, [0], {}, dataCallback, subscribeErr => {
+                expect(subscribeErr).toBeUndefined();
+
+                nRFjprog.rttCloseSharedRing(device.serialNumber, closeErr => {
+                    expect(closeErr).toBeDefined();
+
+                    nRFjprog.rttStopCapture(device.serialNumber, stopErr => {
+                        expect(stopErr).toBeDefined();
+
+                        nRFjprog.rttUnsubscribe(device.serialNumber, unsubscribeErr => {
+                            expect(unsubscribeErr).toBeUndefined();
+                            done();
+                        });
+                    });
+                });
+            });
+        });
+
+        it('receives the loopback data as lines', done => {
+            const writetext = "first line\r\nsecond line\n";
+            const lines = [];
+
+            const dataCallback = (err, chunks) => {
+                expect(err).toBeUndefined();
+
+                chunks.forEach(chunk => lines.push(chunk.data.toString()));
+
+                if (lines.includes('second line')) {
+                    expect(lines.slice(-2)).toEqual(['first line', 'second line']);
+
+                    nRFjprog.rttUnsubscribe(device.serialNumber, err => {
+                        expect(err).toBeUndefined();
+                        done();
+                    });
+                }
+            };
+
+            const subscribeCallback = err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttWrite(device.serialNumber, 0, writetext, err => {
+                    expect(err).toBeUndefined();
+                });
+            };
+
+            nRFjprog.rttSubscribe(device.serialNumber, [0], { framing: nRFjprog.RTT_FRAMING_LINE }, dataCallback, subscribeCallback);
+        });
+
+        it('fails to subscribe twice', done => {
+            const subscribeCallback = err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttSubscribe(device.serialNumber, [0], {}, () => {}, err => {
+                    expect(err).toBeDefined();
+                    done();
+                });
+            };
+
+            nRFjprog.rttSubscribe(device.serialNumber, [0], {}, () => {}, subscribeCallback);
+        });
+    });
+
+    describe('captures to file', () => {
+        const captureFile = path.join(os.tmpdir(), 'pc-nrfjprog-js-rtt-capture.txt');
+
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(up).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, {}, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('writes the loopback data to the file with timestamps', done => {
+            const writetext = "this is a test";
+            let stopped = false;
+
+            const statisticsCallback = (err, statistics) => {
+                expect(err).toBeUndefined();
+                expect(statistics.path).toBe(captureFile);
+
+                if (stopped || statistics.bytesReceived < writetext.length) {
+                    return;
+                }
+
+                stopped = true;
+                nRFjprog.rttStopCapture(device.serialNumber, err => {
+                    expect(err).toBeUndefined();
+
+                    // Raw data is captured unchanged, the times go to the index
+                    const content = fs.readFileSync(captureFile).toString('utf-8');
+                    expect(content).toBe(writetext);
+
+                    const index = fs.readFileSync(`${captureFile}.index`).toString('utf-8');
+                    expect(index).toMatch(/^0 \d+\.\d{6}\n/);
+
+                    done();
+                });
+            };
+
+            const captureCallback = err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttWrite(device.serialNumber, 0, writetext, err => {
+                    expect(err).toBeUndefined();
+                });
+            };
+
+            nRFjprog.rttCapture(device.serialNumber, 0, captureFile, { timestamps: true, statisticsInterval: 100 }, statisticsCallback, captureCallback);
+        });
+    });
+
+    describe('shares a ring with JS', () => {
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(up).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, {}, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('writes the loopback data into the shared ring', done => {
+            const writetext = "this is a test";
+            const headerWords = nRFjprog.RTT_SHARED_RING_HEADER_WORDS;
+            const shared = new SharedArrayBuffer(4 * headerWords + 256);
+            const header = new Uint32Array(shared, 0, headerWords);
+            const ring = new Uint8Array(shared, 4 * headerWords);
+            let received = '';
+            const readStartTime = Date.now();
+
+            const poll = () => {
+                let readIndex = header[nRFjprog.RTT_SHARED_RING_READ_INDEX];
+                const writeIndex = Atomics.load(header, nRFjprog.RTT_SHARED_RING_WRITE_INDEX);
+
+                for (; readIndex !== writeIndex; readIndex = (readIndex + 1) >>> 0) {
+                    received += String.fromCharCode(ring[readIndex % ring.length]);
+                }
+
+                Atomics.store(header, nRFjprog.RTT_SHARED_RING_READ_INDEX, readIndex);
+
+                if (!received.endsWith(writetext) && Date.now() - readStartTime < 2000) {
+                    setTimeout(poll, 10);
+                    return;
+                }
+
+                expect(received.endsWith(writetext)).toBe(true);
+                expect(header[nRFjprog.RTT_SHARED_RING_STATE]).toBe(nRFjprog.RTT_SHARED_RING_RUNNING);
+
+                nRFjprog.rttCloseSharedRing(device.serialNumber, err => {
+                    expect(err).toBeUndefined();
+                    expect(Atomics.load(header, nRFjprog.RTT_SHARED_RING_STATE))
+                        .toBe(nRFjprog.RTT_SHARED_RING_STOPPED);
+
+                    done();
+                });
+            };
+
+            const errorCallback = err => {
+                expect(err).toBeUndefined();
+            };
+
+            nRFjprog.rttOpenSharedRing(device.serialNumber, 0, shared, {}, errorCallback, err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttWrite(device.serialNumber, 0, writetext, writeErr => {
+                    expect(writeErr).toBeUndefined();
+                    poll();
+                });
+            });
+        });
+    });
+
+    describe('queues writes to device', () => {
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(down).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, {}, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('reports drain when the queue above the high water mark is written', done => {
+            const writetext = "this is a test";
+
+            const eventCallback = (err, channelIndex) => {
+                expect(err).toBeUndefined();
+                expect(channelIndex).toBe(0);
+
+                nRFjprog.rttCloseWriteQueue(device.serialNumber, err => {
+                    expect(err).toBeUndefined();
+                    done();
+                });
+            };
+
+            const queueCallback = (err, belowHighWaterMark, queuedLength) => {
+                expect(err).toBeUndefined();
+                expect(belowHighWaterMark).toBe(false);
+                expect(queuedLength).toBeGreaterThan(0);
+            };
+
+            const openCallback = err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.rttQueueWrite(device.serialNumber, 0, writetext, queueCallback);
+            };
+
+            nRFjprog.rttOpenWriteQueue(device.serialNumber, { highWaterMark: 4 }, eventCallback, openCallback);
+        });
+
+        it('fails to queue without a write queue', done => {
+            nRFjprog.rttQueueWrite(device.serialNumber, 0, "this is a test", err => {
+                expect(err).toBeDefined();
+                done();
+            });
+        });
+    });
+
+    describe('buffers on the host', () => {
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                expect(up).toBeDefined();
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, { bufferSize: 64 }, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('reads the loopback data from the buffer and counts it', done => {
+            const writetext = "this is a test";
+            let received = '';
+            let readStartTime = Date.now();
+
+            const statisticsCallback = (err, statistics) => {
+                expect(err).toBeUndefined();
+                expect(statistics[0].channelIndex).toBe(0);
+                expect(statistics[0].capacity).toBe(64);
+                expect(statistics[0].bytesRead).toBeGreaterThanOrEqual(writetext.length);
+                expect(statistics[0].bytesReceived).toBe(statistics[0].bytesRead + statistics[0].bytesDropped + statistics[0].used);
+                expect(statistics[0].highWaterMark).toBeLessThanOrEqual(64);
+
+                done();
+            };
+
+            const readCallback = (err, data) => {
+                expect(err).toBeUndefined();
+                received += data;
+
+                if (!received.endsWith(writetext)
+                    && Date.now() - readStartTime < 2000) {
+                    nRFjprog.rttRead(device.serialNumber, 0, 100, readCallback);
+                    return;
+                }
+
+                expect(received.endsWith(writetext)).toBe(true);
+                nRFjprog.rttGetBufferStatistics(device.serialNumber, statisticsCallback);
+            };
+
+            nRFjprog.rttWrite(device.serialNumber, 0, writetext, err => {
+                expect(err).toBeUndefined();
+
+                readStartTime = Date.now();
+                nRFjprog.rttRead(device.serialNumber, 0, 100, readCallback);
+            });
+        });
+    });
+
+    describe('recovers after errors', () => {
+        let upChannels;
+
+        beforeEach(done => {
+            const startCallback = (err, down, up) => {
+                expect(err).toBeUndefined();
+                upChannels = up;
+
+                done();
+            };
+
+            nRFjprog.rttStart(device.serialNumber, { autoRecover: true }, startCallback);
+        });
+
+        afterEach(done => {
+            const stopCallback = (err) => {
+                expect(err).toBeUndefined();
+                done();
+            };
+
+            nRFjprog.rttStop(device.serialNumber, stopCallback);
+        });
+
+        it('caches the control block location', done => {
+            nRFjprog.rttGetSessionStatistics(device.serialNumber, (err, statistics) => {
+                expect(err).toBeUndefined();
+                expect(statistics.autoRecover).toBe(true);
+                expect(statistics.controlBlockLocation).toBeDefined();
+                expect(statistics.upChannelCount).toBe(upChannels.length);
+                expect(statistics.reconnects).toBe(0);
+                expect(statistics.downtime).toBe(0);
+
+                done();
+            });
+        });
+    });
+
     describe.skip('race condition', () => {
         afterEach(done => {
             const stopCallback = (err) => {
@@ -112,6 +112,29 @@ const singleDeviceNonDesctructive = () => {
         nRFjprog.read(device.serialNumber, 0x0, 1, callback);
     });
 
+    it('counts the bytes read from the device', done => {
+        const readLength = 256;
+
+        nRFjprog.resetThroughputStats(resetErr => {
+            expect(resetErr).toBeUndefined();
+
+            nRFjprog.read(device.serialNumber, 0x0, readLength, err => {
+                expect(err).toBeUndefined();
+
+                nRFjprog.getThroughputStats((statsErr, stats) => {
+                    expect(statsErr).toBeUndefined();
+
+                    const { read, write } = stats[device.serialNumber];
+                    expect(read.bytes).toBe(readLength);
+                    expect(read.transfers).toBe(1);
+                    expect(read.rate).toBeGreaterThan(0);
+                    expect(write.bytes).toBe(0);
+                    done();
+                });
+            });
+        });
+    });
+
     it('reads 5 bytes from specified address', done => {
         const readLength = 5;
 